@@ -0,0 +1,57 @@
+#include "all_associativity.hpp"
+#include <algorithm>
+
+AllAssociativity::AllAssociativity(const ulint &max_bit_set,
+                                   const ulint &max_way,
+                                   const ulint &max_block)
+    : _max_bit_set(max_bit_set), _num_access(0) {
+    for (ulint k = 0; k <= max_bit_set; k++) {
+        ulint num_way = std::min(
+            max_way, std::max(max_block >> k, ALL_ASSOC_MIN_WAY));
+        _num_way.push_back(num_way);
+        _stack.emplace_back((1ULL << k) * num_way, 0);
+        _depth.emplace_back(1ULL << k, 0);
+        _hit.emplace_back(num_way, 0);
+    }
+}
+
+void AllAssociativity::Access(const addr_raw_t &block) {
+    ++_num_access;
+    for (ulint k = 0; k <= _max_bit_set; k++) {
+        ulint num_way = _num_way[k];
+        ulint set = block & ((1ULL << k) - 1);
+        addr_raw_t *stack = &_stack[k][set * num_way];
+        uint32_t &depth = _depth[k][set];
+
+        // Find the block, or drop the LRU entry if the stack is full
+        ulint d = 0;
+        while (d < depth && stack[d] != block) {
+            d++;
+        }
+        if (d < depth) {
+            ++_hit[k][d];
+        } else if (depth < num_way) {
+            ++depth;
+        } else {
+            d = num_way - 1;
+        }
+
+        // Move it to the top of the stack
+        for (; d > 0; d--) {
+            stack[d] = stack[d - 1];
+        }
+        stack[0] = block;
+    }
+}
+
+double AllAssociativity::GetHitRate(const ulint &bit_set,
+                                    const ulint &num_way) const {
+    if (_num_access == 0) {
+        return 0.0;
+    }
+    ulint hit(0);
+    for (ulint d = 0; d < num_way && d < _num_way[bit_set]; d++) {
+        hit += _hit[bit_set][d];
+    }
+    return static_cast<double>(hit) / _num_access;
+}
@@ -0,0 +1,51 @@
+#ifndef _ALL_ASSOCIATIVITY_HPP_
+#define _ALL_ASSOCIATIVITY_HPP_
+
+#include "datatype.hpp"
+#include <vector>
+
+// Smallest associativity range covered for every set count
+const ulint ALL_ASSOC_MIN_WAY = 16;
+
+/*
+    All-associativity simulation (Hill & Smith) of LRU caches with a fixed
+    block size. For every set count 2^k, k = 0 .. max_bit_set, each set
+    keeps an LRU stack of its most recent blocks. By stack inclusion an
+    access found at depth d of its set hits in every cache with 2^k sets
+    and more than d ways, so one pass yields the hit rate of all (sets,
+    ways) pairs.
+
+    Caches larger than max_block blocks are not covered, so 2^k sets have
+    at most max_block >> k ways, but never fewer than ALL_ASSOC_MIN_WAY,
+    and never more than max_way. Every set count costs about max_block
+    stack entries instead of 2^k * max_way.
+*/
+class AllAssociativity {
+  public:
+    explicit AllAssociativity(const ulint &max_bit_set, const ulint &max_way,
+                              const ulint &max_block);
+
+    // Record an access to a block address
+    void Access(const addr_raw_t &block);
+
+    ulint GetAccess() const { return _num_access; }
+    ulint GetMaxBitSet() const { return _max_bit_set; }
+    // # of ways covered with 2^bit_set sets
+    ulint GetNumWay(const ulint &bit_set) const { return _num_way[bit_set]; }
+    // Hit rate of the LRU cache with 2^bit_set sets of num_way ways
+    double GetHitRate(const ulint &bit_set, const ulint &num_way) const;
+
+  private:
+    ulint _max_bit_set;
+    ulint _num_access;
+
+    // For each set count: the # of ways, the stacks of all sets (MRU
+    // first, one entry per way), the # of valid entries of each set, and
+    // the # of hits at each depth
+    std::vector<ulint> _num_way;
+    std::vector<std::vector<addr_raw_t>> _stack;
+    std::vector<std::vector<uint32_t>> _depth;
+    std::vector<std::vector<ulint>> _hit;
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "arc_replacement.hpp"
+
+ARCReplacement::ARCReplacement(const ReplacePolicies &policy,
+                               const ulint &num_set, const ulint &num_way)
+    : BaseReplacement(num_set, num_way), _policy(policy), _target(0),
+      // One more ghost than ways, a ghost hit keeps its node until the fill
+      _ghosts(policy == CAR ? "CAR" : "ARC", num_set, num_way, num_way + 1),
+      _lists(2 * num_way + 1, NUM_LIST), _block(num_way, 0), _ref(num_way, 0),
+      _fill_ghost(NO_NODE), _fill_list(T1) {}
+
+void ARCReplacement::Hit(const ulint &, const ulint &way) {
+    if (_policy == CAR) {
+        _ref[way] = 1;
+        return;
+    }
+    _lists.Remove(way);
+    _lists.PushTail(T2, way);
+}
+
+void ARCReplacement::Fill(const ulint &, const ulint &way,
+                          const addr_t &block) {
+    if (_fill_ghost != NO_NODE) {
+        // CAR adapts the target after the replacement, ARC before it
+        if (_policy == CAR && _lists.Owner(_fill_ghost) == B1) {
+            _target = std::min(_num_way, _target + _Ratio(B2, B1));
+        } else if (_policy == CAR) {
+            _target -= std::min(_target, _Ratio(B1, B2));
+        }
+        _DropGhost(_fill_ghost);
+    }
+    _block[way] = block;
+    _ref[way] = 0;
+    _lists.PushTail(_fill_list, way);
+}
+
+ulint ARCReplacement::GetVictim(const ulint &, const addr_t &block) {
+    _fill_ghost = _ghosts.Find(block);
+    _ListId ghost_list = _fill_ghost == NO_NODE
+                             ? NUM_LIST
+                             : static_cast<_ListId>(_lists.Owner(_fill_ghost));
+    _fill_list = ghost_list == NUM_LIST ? T1 : T2;
+
+    uint32_t free_way = _ghosts.PopFreeWay();
+    if (free_way != NO_NODE) {
+        return free_way;
+    }
+
+    if (_policy == CAR) {
+        // The directory of resident and ghost blocks is trimmed after the
+        // replacement, which left c - 1 resident blocks
+        ulint way = _ReplaceCAR();
+        if (ghost_list == NUM_LIST) {
+            if (_lists.Size(T1) + _lists.Size(B1) == _num_way) {
+                _DropGhost(_lists.Head(B1));
+            } else if (_lists.Size(B1) + _lists.Size(B2) == _num_way + 1) {
+                _DropGhost(_lists.Head(B2));
+            }
+        }
+        return way;
+    }
+
+    if (ghost_list == B1) {
+        _target = std::min(_num_way, _target + _Ratio(B2, B1));
+        return _ReplaceARC(false);
+    }
+    if (ghost_list == B2) {
+        _target -= std::min(_target, _Ratio(B1, B2));
+        return _ReplaceARC(true);
+    }
+    if (_lists.Size(T1) + _lists.Size(B1) == _num_way) {
+        if (_lists.Size(T1) < _num_way) {
+            _DropGhost(_lists.Head(B1));
+            return _ReplaceARC(false);
+        }
+        // T1 holds the whole cache, its LRU block leaves no ghost
+        ulint way = _lists.Head(T1);
+        _lists.Remove(way);
+        return way;
+    }
+    // The cache is full, so is the directory if there are c ghosts
+    if (_lists.Size(B1) + _lists.Size(B2) == _num_way) {
+        _DropGhost(_lists.Head(B2));
+    }
+    return _ReplaceARC(false);
+}
+
+ulint ARCReplacement::_ReplaceARC(const bool &in_b2) {
+    ulint size = _lists.Size(T1);
+    if (size >= 1 && (size > _target || (in_b2 && size == _target) ||
+                      _lists.Size(T2) == 0)) {
+        return _Demote(T1, B1);
+    }
+    return _Demote(T2, B2);
+}
+
+ulint ARCReplacement::_ReplaceCAR() {
+    // Sweep the clocks, referenced ways get a second chance in T2
+    for (;;) {
+        _ListId from =
+            _lists.Size(T1) >= std::max<ulint>(1, _target) ? T1 : T2;
+        uint32_t way = _lists.Head(from);
+        if (!_ref[way]) {
+            return _Demote(from, from == T1 ? B1 : B2);
+        }
+        _ref[way] = 0;
+        _lists.Remove(way);
+        _lists.PushTail(T2, way);
+    }
+}
+
+ulint ARCReplacement::_Demote(const _ListId &from, const _ListId &to) {
+    uint32_t way = _lists.Head(from);
+    _lists.Remove(way);
+    _lists.PushTail(to, _ghosts.Add(_block[way]));
+    return way;
+}
+
+void ARCReplacement::_DropGhost(const uint32_t &node) {
+    _lists.Remove(node);
+    _ghosts.Drop(node);
+}
@@ -0,0 +1,55 @@
+#ifndef _ARC_REPLACEMENT_HPP_
+#define _ARC_REPLACEMENT_HPP_
+
+#include "ghost_table.hpp"
+#include "replacement.hpp"
+#include <algorithm>
+
+/*
+    ARC (Megiddo and Modha, FAST 2003) and its CLOCK variant CAR (Bansal
+    and Modha, FAST 2004) for fully-associative caches of c ways.
+
+    Resident blocks are in T1 (seen once recently) or T2 (seen at least
+    twice), the ghost lists B1 and B2 remember the blocks last evicted from
+    them, and the target size p of T1 grows on B1 hits and shrinks on B2
+    hits. ARC keeps T1 and T2 in LRU order, CAR keeps them as clocks whose
+    hits only set a reference bit.
+
+    Every list is intrusive over the nodes of a GhostTable with c + 1
+    ghosts. The head of a list is its LRU end or clock hand.
+*/
+class ARCReplacement final : public BaseReplacement {
+  public:
+    explicit ARCReplacement(const ReplacePolicies &policy,
+                            const ulint &num_set, const ulint &num_way);
+    void Hit(const ulint &set, const ulint &way);
+    void Fill(const ulint &set, const ulint &way, const addr_t &block);
+    ulint GetVictim(const ulint &set, const addr_t &block);
+
+  private:
+    enum _ListId : uint8_t { T1, T2, B1, B2, NUM_LIST };
+
+    ulint _ReplaceARC(const bool &in_b2);
+    ulint _ReplaceCAR();
+    // Move the head way of a resident list to the MRU end of a ghost list
+    ulint _Demote(const _ListId &from, const _ListId &to);
+    void _DropGhost(const uint32_t &node);
+    ulint _Ratio(const _ListId &num, const _ListId &den) const {
+        return std::max<ulint>(1, _lists.Size(num) / _lists.Size(den));
+    }
+
+    ReplacePolicies _policy; // ARC or CAR
+    ulint _target;           // p, target size of T1
+
+    GhostTable _ghosts;
+    NodeLists _lists;
+    std::vector<addr_t> _block; // block of each way
+    std::vector<uint8_t> _ref;  // CAR reference bit of each way
+
+    // Ghost node of the block being filled and the list it goes to, set by
+    // GetVictim() for the following Fill()
+    uint32_t _fill_ghost;
+    _ListId _fill_list;
+};
+
+#endif
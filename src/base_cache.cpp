@@ -1,10 +1,76 @@
 #include "base_cache.hpp"
+#include <bit>
 
 BaseCache::BaseCache(const CacheProperty &setting) : property(setting) {
+    ResolveCacheGeometry(property);
 
+    switch (property.associativity) {
+    case full_associative:
+        _set_mask = 0;
+        _set_ways = property._num_block;
+        break;
+    case direct_mapped:
+        _set_mask = property._num_block - 1;
+        _set_ways = 1;
+        break;
+    case set_associative:
+        _set_mask = property._num_set - 1;
+        _set_ways = property._num_way;
+        break;
+    }
+    _tag_shift = property._addr_width - property._bit_tag;
+
+    if (property.associativity != direct_mapped) {
+        _replacement =
+            MakeReplacement(property, _set_mask + 1, _set_ways);
+    }
+}
+
+void ResolveCacheGeometry(CacheProperty &property) {
     // set cache block size/bit
-    property._bit_offset = log2l(setting._block_size);
-    for (auto _line : _cache) {
-        _line.reset();
+    property._bit_offset = log2l(property._block_size);
+    property._num_block = (property._cache_size << 10) / property._block_size;
+
+    switch (property.associativity) {
+    case full_associative:
+        /* For fully associative, remaining bits are used for TAG*/
+        property._bit_index = 0;
+        property._bit_set = 0;
+        break;
+    case direct_mapped:
+        property._bit_index = log2l(property._num_block);
+        property._bit_set = 0;
+        break;
+    case set_associative:
+        property._bit_index = 0;
+        property._num_set = property._num_block / property._num_way;
+        property._bit_set = log2l(property._num_set);
+        break;
+    }
+
+    // Sets are indexed by masking address bits
+    ulint num_set = property.associativity == direct_mapped
+                        ? property._num_block
+                        : property._num_set;
+    if (property.associativity != full_associative &&
+        !std::has_single_bit(num_set)) {
+        std::cerr << "# of sets " << num_set << " is not a power of two"
+                  << std::endl;
+        exit(-1);
+    }
+
+    if (property._addr_width > 64) {
+        std::cerr << "Address width " << property._addr_width
+                  << " is too large, at most 64 bits are supported"
+                  << std::endl;
+        exit(-1);
+    }
+    ulint bit_used =
+        property._bit_offset + property._bit_index + property._bit_set;
+    if (bit_used >= property._addr_width) {
+        std::cerr << "Address width " << property._addr_width
+                  << " is too small for the cache geometry" << std::endl;
+        exit(-1);
     }
-}
\ No newline at end of file
+    property._bit_tag = property._addr_width - bit_used;
+}
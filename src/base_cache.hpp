@@ -2,10 +2,14 @@
 #define _BASE_CACHE_HPP
 
 #include "datatype.hpp"
+#include "replacement.hpp"
 #include <cmath>
+#include <span>
 
-const int MAX_LINE = 65536;
-
+/*
+    Geometry and replacement state shared by caches of every tag width,
+    the tag store and lookups are in MainCache<Tag>.
+*/
 class BaseCache {
   public:
     BaseCache();
@@ -15,16 +19,37 @@ class BaseCache {
     virtual bool Get(const addr_t &) = 0;
     virtual bool Set(const addr_t &) = 0;
     virtual bool IsHit(const addr_t &) = 0;
+    // Get() each access of batch and Set() the ones that missed, which are
+    // appended to misses in order, I_NONE entries are skipped
+    virtual void Access(std::span<const inst_t> batch,
+                        std::vector<inst_t> &misses) = 0;
 
     CacheProperty GetProperty() { return property; }
+    ulint GetNumSet() const { return _set_mask + 1; }
+    ulint GetSetNumber(const addr_t &addr) const {
+        return _GetSetNumber(addr);
+    }
+    bool IsSetLocal() const {
+        return !_replacement || _replacement->IsSetLocal();
+    }
 
   protected:
-    /*  [30]: valid [29]: dirty bit [28]~[0]: data
-        [31]: enable*/
-    addr_t _cache[MAX_LINE];
+    ulint _GetSetNumber(const addr_t &addr) const {
+        return (addr >> property._bit_offset) & _set_mask;
+    }
+
+    ulint _tag_shift; // tag = addr >> _tag_shift
+    ulint _set_mask;  // mask of set number (line index if direct-mapped)
+    ulint _set_ways;  // # of lines searched by each lookup
+
+    // Victim selection, none for direct-mapped caches
+    std::unique_ptr<BaseReplacement> _replacement;
 
     // Cache properties
     CacheProperty property;
 };
 
-#endif
\ No newline at end of file
+// Fill in the # of blocks and the offset/index/set/tag bits of a cache
+void ResolveCacheGeometry(CacheProperty &property);
+
+#endif
@@ -29,6 +29,9 @@ void ParseCacheConfig(const char *filename, std::vector<CacheProperty> &dest,
     }
 
     is_multi_level = cache_conf["multi-level"];
+    // Every level of the hierarchy sees the same addresses
+    ulint addr_width = cache_conf.value("address-width", DEFAULT_ADDR_WIDTH);
+    ulint seed = cache_conf.value("seed", DEFAULT_SEED);
 
     auto _cache_array = cache_conf["content"];
 
@@ -38,6 +41,8 @@ void ParseCacheConfig(const char *filename, std::vector<CacheProperty> &dest,
         try {
             _c._cache_size = (*it)["cache-size"];
             _c._block_size = (*it)["block-size"];
+            _c._addr_width = addr_width;
+            _c._seed = seed;
             std::string _str((*it)["associativity"]);
             if (_str == "direct-mapped")
                 _c.associativity = direct_mapped;
@@ -57,11 +62,43 @@ void ParseCacheConfig(const char *filename, std::vector<CacheProperty> &dest,
                 _c.replacement_policy = RANDOM;
             else if (_str == "LRU" || _str == "lru")
                 _c.replacement_policy = LRU;
+            else if (_str == "PLRU" || _str == "plru")
+                _c.replacement_policy = PLRU;
+            else if (_str == "SRRIP" || _str == "srrip")
+                _c.replacement_policy = SRRIP;
+            else if (_str == "BRRIP" || _str == "brrip")
+                _c.replacement_policy = BRRIP;
+            else if (_str == "DRRIP" || _str == "drrip")
+                _c.replacement_policy = DRRIP;
+            else if (_str == "OPT" || _str == "opt")
+                _c.replacement_policy = OPT;
+            else if (_str == "ARC" || _str == "arc")
+                _c.replacement_policy = ARC;
+            else if (_str == "CAR" || _str == "car")
+                _c.replacement_policy = CAR;
+            else if (_str == "LIRS" || _str == "lirs")
+                _c.replacement_policy = LIRS;
+            else if (_str == "2Q" || _str == "2q")
+                _c.replacement_policy = TWOQ;
+            else if (_str == "SHIP" || _str == "ship")
+                _c.replacement_policy = SHIP;
+            else if (_str == "HAWKEYE" || _str == "hawkeye")
+                _c.replacement_policy = HAWKEYE;
+            else if (_str == "CLOCK" || _str == "clock")
+                _c.replacement_policy = CLOCK;
+            else if (_str == "NRU" || _str == "nru")
+                _c.replacement_policy = NRU;
             else {
                 std::cerr << "Unknown replacement policy of cache:" << '\n'
                           << _str << std::endl;
                 exit(-1);
             }
+            _c._rrpv_bits = (*it).value("rrpv-bits", DEFAULT_RRPV_BITS);
+            // RRPVs are kept in one byte per line
+            if (_c._rrpv_bits < 1 || _c._rrpv_bits > 8) {
+                std::cerr << "RRPV width must be 1 to 8 bits" << std::endl;
+                exit(-1);
+            }
         } catch (const json::type_error &e) {
             std::cerr << "message: " << e.what() << '\n'
                       << "exception id: " << e.id << std::endl;
@@ -1,17 +1,26 @@
 #ifndef _DATATYPE_HPP_
 #define _DATATYPE_HPP_
 
-#include <bitset>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 using ulint = uint64_t;
 using addr_raw_t = uint64_t;
-using addr_t = std::bitset<32>;
+using addr_t = uint64_t;
+// Tags of caches whose tag fits in 32 bits, wider tags use wide_tag_t
+using tag_t = uint32_t;
+using wide_tag_t = uint64_t;
 
-inline addr_raw_t Cvt2AddrRaw(addr_t addr) { return addr.to_ullong(); }
-
-inline addr_t Cvt2AddrBits(addr_raw_t raw_addr) { return addr_t(raw_addr); }
+// Address width of a config file without "address-width"
+const ulint DEFAULT_ADDR_WIDTH = 32;
+// Seed of random replacement of a config file without "seed"
+const ulint DEFAULT_SEED = 0;
+// Width of RRIP re-reference prediction values without "rrpv-bits"
+const ulint DEFAULT_RRPV_BITS = 2;
 
 enum INST_OP { I_LOAD, I_STORE, I_NONE };
 
@@ -32,7 +41,20 @@ enum ReplacePolicies {
     // Cache replacement policies
     NONE,
     RANDOM,
-    LRU
+    LRU,
+    PLRU,    // tree pseudo-LRU
+    SRRIP,   // static re-reference interval prediction
+    BRRIP,   // bimodal RRIP
+    DRRIP,   // SRRIP or BRRIP by set dueling
+    OPT,     // Belady's offline optimum
+    ARC,     // adaptive replacement cache
+    CAR,     // CLOCK with adaptive replacement
+    LIRS,    // low inter-reference recency set
+    TWOQ,    // 2Q, FIFO of new blocks and LRU of hot ones
+    SHIP,    // signature-based hit prediction
+    HAWKEYE, // OPTgen-trained hit prediction
+    CLOCK,   // second chance
+    NRU      // not recently used
 };
 
 enum WritePolicies {
@@ -40,6 +62,8 @@ enum WritePolicies {
     write_back
 };
 
+class NextUseIndex;
+
 struct CacheProperty {
     MappingPolicies associativity;
     ReplacePolicies replacement_policy;
@@ -47,6 +71,9 @@ struct CacheProperty {
 
     ulint _cache_size;
     ulint _block_size;
+    ulint _addr_width; // # of bits of address
+    ulint _seed;       // seed of random replacement
+    ulint _rrpv_bits;  // # of bits of RRIP prediction values
 
     ulint _bit_offset; // # of bits of offset
     ulint _bit_index;  // # of bits of index
@@ -57,11 +84,24 @@ struct CacheProperty {
     ulint _num_way;   // N-way
     ulint _num_set;   // # of sets
 
+    // Future accesses of the trace, only for OPT replacement
+    std::shared_ptr<const NextUseIndex> _next_use;
+
     explicit CacheProperty()
         : associativity(direct_mapped), replacement_policy(NONE),
           write_policy(write_back), _cache_size(0), _block_size(0),
-          _bit_offset(0), _bit_index(0), _bit_set(0), _bit_tag(0),
-          _num_block(0), _num_way(0), _num_set(0) {}
+          _addr_width(DEFAULT_ADDR_WIDTH), _seed(DEFAULT_SEED),
+          _rrpv_bits(DEFAULT_RRPV_BITS), _bit_offset(0), _bit_index(0),
+          _bit_set(0), _bit_tag(0), _num_block(0), _num_way(0),
+          _num_set(0) {}
+};
+
+struct HierarchyConfig {
+    std::string name;                      // config file it comes from
+    bool multi_level;                      // simulate all levels or L1 only
+    std::vector<CacheProperty> cache_list; // L1, L2, ...
+
+    explicit HierarchyConfig() : multi_level(false) {}
 };
 
 #endif
\ No newline at end of file
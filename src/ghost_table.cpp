@@ -0,0 +1,31 @@
+#include "ghost_table.hpp"
+
+GhostTable::GhostTable(const std::string &name, const ulint &num_set,
+                       const ulint &num_way, const ulint &num_ghost)
+    : _num_way(num_way), _block(num_ghost, 0) {
+    if (num_set != 1) {
+        std::cerr << name << " replacement needs a full-associative cache"
+                  << std::endl;
+        exit(-1);
+    }
+    // Empty ways are filled lowest first, and so are free ghost nodes
+    for (ulint way = num_way; way > 0; way--) {
+        _free_way.push_back(way - 1);
+    }
+    for (ulint node = num_way + num_ghost; node > num_way; node--) {
+        _free_ghost.push_back(node - 1);
+    }
+}
+
+uint32_t GhostTable::Add(const addr_t &block) {
+    uint32_t node = _free_ghost.back();
+    _free_ghost.pop_back();
+    _block[node - _num_way] = block;
+    _ghost[block] = node;
+    return node;
+}
+
+void GhostTable::Drop(const uint32_t &node) {
+    _ghost.erase(_block[node - _num_way]);
+    _free_ghost.push_back(node);
+}
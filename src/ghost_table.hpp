@@ -0,0 +1,51 @@
+#ifndef _GHOST_TABLE_HPP_
+#define _GHOST_TABLE_HPP_
+
+#include "node_list.hpp"
+#include <unordered_map>
+
+/*
+    Bounded history of blocks evicted from a fully-associative cache of c
+    ways, for policies that keep their ways and ghost entries as nodes of
+    NodeLists. Nodes [0, c) are the ways, nodes [c, c + g) hold the g ghost
+    blocks, found by a hash map of block addresses. The table only tracks
+    which nodes are free and which block each ghost stands for, the policy
+    keeps the nodes in its lists and drops a ghost before the table is full.
+*/
+class GhostTable {
+  public:
+    // Exits if the cache is not fully associative, name is the policy
+    explicit GhostTable(const std::string &name, const ulint &num_set,
+                        const ulint &num_way, const ulint &num_ghost);
+
+    // Lowest empty way, NO_NODE once the cache is full. Nothing has been
+    // evicted before that.
+    uint32_t PopFreeWay() {
+        if (_free_way.empty()) {
+            return NO_NODE;
+        }
+        uint32_t way = _free_way.back();
+        _free_way.pop_back();
+        return way;
+    }
+
+    // Ghost node of a block, NO_NODE if it has none
+    uint32_t Find(const addr_t &block) const {
+        auto it = _ghost.find(block);
+        return it == _ghost.end() ? NO_NODE : it->second;
+    }
+    bool IsFull() const { return _free_ghost.empty(); }
+    // Remember an evicted block in a free ghost node, returned
+    uint32_t Add(const addr_t &block);
+    // Forget the block of a ghost node, the node must have left its lists
+    void Drop(const uint32_t &node);
+
+  private:
+    ulint _num_way;
+    std::vector<addr_t> _block; // block of each ghost node
+    std::vector<uint32_t> _free_way;
+    std::vector<uint32_t> _free_ghost;
+    std::unordered_map<addr_t, uint32_t> _ghost; // block -> ghost node
+};
+
+#endif
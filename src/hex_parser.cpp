@@ -0,0 +1,80 @@
+#include "hex_parser.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define HEX_PARSER_X86
+#endif
+
+static bool _ParseHexScalar(const char *digits, ulint n, addr_raw_t &value) {
+    addr_raw_t res(0);
+    for (ulint i = 0; i < n; i++) {
+        unsigned digit = static_cast<unsigned char>(digits[i]) - '0';
+        if (digit > 9) {
+            digit = (static_cast<unsigned char>(digits[i]) | 0x20) - 'a' + 10;
+            if (digit < 10 || digit > 15) {
+                return false;
+            }
+        }
+        res = (res << 4) | digit;
+    }
+    value = res;
+    return true;
+}
+
+#ifdef HEX_PARSER_X86
+
+__attribute__((target("ssse3"))) static bool
+_ParseHexSSSE3(const char *digits, ulint n, addr_raw_t &value) {
+    if (n != 8 && n != 16) {
+        return _ParseHexScalar(digits, n, value);
+    }
+
+    // 8 digits are padded with '0' up to 16, then shifted out at the end
+    __m128i chars =
+        n == 16 ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(digits))
+                : _mm_unpacklo_epi64(
+                      _mm_loadl_epi64(
+                          reinterpret_cast<const __m128i *>(digits)),
+                      _mm_set1_epi8('0'));
+
+    // '0'-'9' -> 0-9, 'a'-'f' and 'A'-'F' -> 10-15
+    __m128i num = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i is_num = _mm_cmpeq_epi8(_mm_min_epu8(num, _mm_set1_epi8(9)), num);
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)),
+                                 _mm_set1_epi8('a'));
+    __m128i is_alpha =
+        _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    if (_mm_movemask_epi8(_mm_or_si128(is_num, is_alpha)) != 0xFFFF) {
+        return false;
+    }
+    __m128i nibble = _mm_or_si128(
+        _mm_and_si128(is_num, num),
+        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+
+    // Merge digit pairs into bytes (first digit is the high nibble), then
+    // bytes into a big-endian 64-bit word
+    __m128i pairs = _mm_maddubs_epi16(nibble, _mm_set1_epi16(0x0110));
+    uint64_t word = _mm_cvtsi128_si64(_mm_packus_epi16(pairs, pairs));
+    value = __builtin_bswap64(word) >> (64 - 4 * n);
+    return true;
+}
+
+#endif
+
+HexParseFunc GetHexParserSIMD() {
+#ifdef HEX_PARSER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        return _ParseHexSSSE3;
+    }
+#endif
+    return nullptr;
+}
+
+static HexParseFunc _SelectHexParser() {
+    HexParseFunc simd = GetHexParserSIMD();
+    return simd != nullptr ? simd : _ParseHexScalar;
+}
+
+const HexParseFunc ParseHexScalar = _ParseHexScalar;
+const HexParseFunc ParseHexFixed = _SelectHexParser();
@@ -0,0 +1,21 @@
+#ifndef _HEX_PARSER_HPP_
+#define _HEX_PARSER_HPP_
+
+#include "datatype.hpp"
+
+/*
+    Decode exactly n hex digits (8 or 16, no "0x" prefix) into value.
+    Returns false, leaving value untouched, if any of them is not a hex
+    digit. An SSSE3 kernel is picked at startup when the CPU supports it,
+    otherwise a scalar loop is used.
+*/
+using HexParseFunc = bool (*)(const char *digits, ulint n, addr_raw_t &value);
+
+extern const HexParseFunc ParseHexFixed;
+
+// The scalar loop, and the SIMD kernel or nullptr if the CPU has none, to
+// check them against each other
+extern const HexParseFunc ParseHexScalar;
+HexParseFunc GetHexParserSIMD();
+
+#endif
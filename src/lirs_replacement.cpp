@@ -0,0 +1,102 @@
+#include "lirs_replacement.hpp"
+
+LIRSReplacement::LIRSReplacement(const ulint &num_set, const ulint &num_way)
+    : BaseReplacement(num_set, num_way),
+      _max_lir(num_way -
+               std::max<ulint>(1, num_way * LIRS_HIR_PERCENT / 100)),
+      _num_lir(0), _ghosts("LIRS", num_set, num_way, num_way),
+      _stack(2 * num_way, 1), _queue(2 * num_way, 2), _block(num_way, 0),
+      _lir(num_way, 0), _fill_lir(false) {}
+
+void LIRSReplacement::Hit(const ulint &, const ulint &way) {
+    bool in_stack = _stack.Owner(way) == S;
+    bool bottom = _stack.Head(S) == way;
+    if (in_stack) {
+        _stack.Remove(way);
+    }
+    _stack.PushTail(S, way);
+
+    if (_lir[way]) {
+        if (bottom) {
+            _Prune();
+        }
+        return;
+    }
+    _queue.Remove(way);
+    if (in_stack) {
+        _lir[way] = 1;
+        _DemoteBottom();
+    } else {
+        _queue.PushTail(Q, way);
+    }
+}
+
+void LIRSReplacement::Fill(const ulint &, const ulint &way,
+                           const addr_t &block) {
+    _block[way] = block;
+    _stack.PushTail(S, way);
+    // The first blocks are LIR until there are enough of them
+    if (_fill_lir || _num_lir < _max_lir) {
+        _lir[way] = 1;
+        if (_fill_lir) {
+            _DemoteBottom();
+        } else {
+            ++_num_lir;
+        }
+        return;
+    }
+    _lir[way] = 0;
+    _queue.PushTail(Q, way);
+}
+
+ulint LIRSReplacement::GetVictim(const ulint &, const addr_t &block) {
+    uint32_t node = _ghosts.Find(block);
+    _fill_lir = node != NO_NODE;
+    if (_fill_lir) {
+        _DropGhost(node);
+    }
+
+    uint32_t free_way = _ghosts.PopFreeWay();
+    if (free_way != NO_NODE) {
+        return free_way;
+    }
+
+    uint32_t way = _queue.Head(Q);
+    _queue.Remove(way);
+    if (_stack.Owner(way) == S) {
+        // Still recent enough to matter, keep it in S as a ghost
+        if (_ghosts.IsFull()) {
+            _DropGhost(_queue.Head(GHOST));
+        }
+        uint32_t ghost = _ghosts.Add(_block[way]);
+        _stack.Replace(way, ghost);
+        _queue.PushTail(GHOST, ghost);
+    }
+    return way;
+}
+
+void LIRSReplacement::_DemoteBottom() {
+    uint32_t way = _stack.Head(S);
+    _stack.Remove(way);
+    _lir[way] = 0;
+    _queue.PushTail(Q, way);
+    _Prune();
+}
+
+void LIRSReplacement::_Prune() {
+    for (uint32_t node = _stack.Head(S);
+         node != NO_NODE && (node >= _num_way || !_lir[node]);
+         node = _stack.Head(S)) {
+        if (node >= _num_way) {
+            _DropGhost(node);
+        } else {
+            _stack.Remove(node);
+        }
+    }
+}
+
+void LIRSReplacement::_DropGhost(const uint32_t &node) {
+    _stack.Remove(node);
+    _queue.Remove(node);
+    _ghosts.Drop(node);
+}
@@ -0,0 +1,52 @@
+#ifndef _LIRS_REPLACEMENT_HPP_
+#define _LIRS_REPLACEMENT_HPP_
+
+#include "ghost_table.hpp"
+#include "replacement.hpp"
+#include <algorithm>
+
+// Ways holding HIR blocks in percent of the cache, at least one
+const ulint LIRS_HIR_PERCENT = 1;
+
+/*
+    LIRS (Jiang and Zhang, SIGMETRICS 2002) for fully-associative caches.
+    LIR blocks, reused soon after their previous access, keep all but Lhirs
+    ways; HIR blocks share the others in the FIFO Q and are the only ones
+    evicted. The stack S orders the recently accessed blocks from oldest
+    (head) to newest and is pruned so that its oldest block is LIR. An HIR
+    block accessed while still in S was reused sooner than that block and
+    takes its place among the LIR blocks.
+
+    Evicted HIR blocks stay in S as ghosts of a GhostTable until pruned.
+    Once c ghosts exist the oldest one is forgotten.
+*/
+class LIRSReplacement final : public BaseReplacement {
+  public:
+    explicit LIRSReplacement(const ulint &num_set, const ulint &num_way);
+    void Hit(const ulint &, const ulint &way);
+    void Fill(const ulint &, const ulint &way, const addr_t &block);
+    ulint GetVictim(const ulint &, const addr_t &block);
+
+  private:
+    // _stack holds the list S, _queue the lists Q and GHOST
+    enum _ListId : uint8_t { S = 0, Q = 0, GHOST = 1 };
+
+    // Move the LIR block at the bottom of S to the end of Q as HIR
+    void _DemoteBottom();
+    // Pop HIR blocks from the bottom of S
+    void _Prune();
+    void _DropGhost(const uint32_t &node);
+
+    ulint _max_lir; // c - Lhirs
+    ulint _num_lir;
+    GhostTable _ghosts;
+    NodeLists _stack;
+    NodeLists _queue;           // resident HIR ways and ghosts by age
+    std::vector<addr_t> _block; // block of each way
+    std::vector<uint8_t> _lir;  // LIR bit of each way
+
+    // The block being filled had a ghost in S, set by GetVictim()
+    bool _fill_lir;
+};
+
+#endif
@@ -1,52 +1,233 @@
 #include "loader.hpp"
+#include "hex_parser.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 InstructionLoader::InstructionLoader(const std::string &trace_filename) {
     LoadTraceFile(trace_filename);
 }
 
 InstructionLoader::~InstructionLoader() {
-    if (in_file == nullptr) {
+    _UnmapTraceFile();
+    if (in_file != nullptr) {
         in_file->close();
     }
 }
 
 void InstructionLoader::LoadTraceFile(const std::string &filename) {
+    _UnmapTraceFile();
+    if (_MapTraceFile(filename)) {
+        return;
+    }
+
     in_file = std::make_unique<std::ifstream>(filename.c_str(), std::ios::in);
     if (in_file->fail()) {
         std::cerr << "Open trace file error" << std::endl;
         exit(-1);
     }
+    if (in_file->peek() == TRACE_MAGIC[0]) {
+        std::cerr << "Binary trace must be a regular file" << std::endl;
+        exit(-1);
+    }
+}
+
+bool InstructionLoader::_MapTraceFile(const std::string &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+    _map_begin = static_cast<const char *>(addr);
+    _map_cursor = _map_begin;
+    _map_end = _map_begin + st.st_size;
+    _map_size = st.st_size;
+
+    _is_binary = IsBinaryTrace(_map_begin, _map_size);
+    if (_is_binary) {
+        TraceHeader header;
+        std::memcpy(&header, _map_begin, sizeof(header));
+        if (header.version != TRACE_FORMAT_VERSION ||
+            (header.addr_width != 32 && header.addr_width != 64)) {
+            std::cerr << "Unsupported binary trace version "
+                      << header.version << " or address width "
+                      << header.addr_width << std::endl;
+            exit(-1);
+        }
+        _addr_width = header.addr_width;
+        _record_size = TraceRecordSize(_addr_width);
+        if ((_map_size - sizeof(header)) / _record_size < header.num_record) {
+            std::cerr << "Truncated binary trace file" << std::endl;
+            exit(-1);
+        }
+        _map_cursor = _map_begin + sizeof(header);
+        _map_end = _map_cursor + header.num_record * _record_size;
+    }
+    return true;
+}
+
+void InstructionLoader::_UnmapTraceFile() {
+    if (_map_begin != nullptr) {
+        munmap(const_cast<char *>(_map_begin), _map_size);
+        _map_begin = _map_cursor = _map_end = nullptr;
+        _map_size = 0;
+        _is_binary = false;
+    }
 }
 
 inst_t InstructionLoader::GetNextInst() {
-    const int LENGTH_OF_INST_LINE = 13;
-    char trace_line[13];
+    if (_is_binary) {
+        const char *record = _map_cursor;
+        _map_cursor += _record_size;
+        return _ParseRecordToInst(record);
+    }
+    if (_map_begin != nullptr) {
+        return _ParseMappedLine();
+    }
+
+    // Lines are 12 characters for 32-bit and 20 for 64-bit addresses
+    std::string trace_line;
+    std::getline(*in_file, trace_line);
+    return _ParseLineToInst(trace_line.data(),
+                            trace_line.data() + trace_line.size());
+}
 
-    in_file->getline(trace_line, LENGTH_OF_INST_LINE);
+ulint InstructionLoader::GetNextBatch(std::span<inst_t> batch) {
+    ulint n(0);
+    if (_is_binary) {
+        ulint remain = (_map_end - _map_cursor) / _record_size;
+        n = std::min<ulint>(batch.size(), remain);
+        for (ulint i = 0; i < n; i++) {
+            batch[i] = _ParseRecordToInst(_map_cursor);
+            _map_cursor += _record_size;
+        }
+        return n;
+    }
+
+    if (_map_begin != nullptr) {
+        for (; n < batch.size() && _map_cursor < _map_end; n++) {
+            batch[n] = _ParseMappedLine();
+        }
+        return n;
+    }
+
+    for (; n < batch.size() && IfAvailable(); n++) {
+        batch[n] = GetNextInst();
+    }
+    return n;
+}
 
-    return _ParseLineToInst(trace_line);
+inst_t InstructionLoader::_ParseMappedLine() {
+    const char *line = _map_cursor;
+    const char *end =
+        static_cast<const char *>(std::memchr(line, '\n', _map_end - line));
+    if (end == nullptr) {
+        // Last line without trailing newline
+        end = _map_end;
+        _map_cursor = _map_end;
+    } else {
+        _map_cursor = end + 1;
+    }
+    return _ParseLineToInst(line, end);
 }
 
-bool InstructionLoader::IfAvailable() { return !(in_file->eof()); }
+bool InstructionLoader::IfAvailable() {
+    if (_map_begin != nullptr) {
+        return _map_cursor < _map_end;
+    }
+    // A failed read ends the input as well, it would never reach EOF
+    return in_file->good();
+}
 
-inst_t InstructionLoader::_ParseLineToInst(const char *line) {
+inst_t InstructionLoader::_ParseLineToInst(const char *line,
+                                           const char *end) {
     inst_t res_inst;
-    const int INST_ADDR_BASE = 16;
-    addr_raw_t addr = (addr_raw_t)strtoul(line + 2, nullptr, INST_ADDR_BASE);
+    if (line == end) {
+        res_inst.op = I_NONE;
+        return res_inst;
+    }
+
+    // Fast path for the fixed "l 0x" + 8 or 16 digits format
+    const ulint line_length = end - line;
+    if ((line_length == 12 || line_length == 20) && line[1] == ' ' &&
+        line[2] == '0' && (line[3] | 0x20) == 'x' &&
+        ParseHexFixed(line + 4, line_length - 4, res_inst.addr_raw)) {
+        return _SetInstOp(res_inst, line, end);
+    }
+
+    // Parse "0x..." hex address after the op character, the line is not
+    // NUL-terminated when it points into the mapped file
+    const char *p = line + 1;
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+    }
+    addr_raw_t addr(0);
+    for (; p < end; ++p) {
+        unsigned digit = static_cast<unsigned char>(*p) - '0';
+        if (digit > 9) {
+            digit = (static_cast<unsigned char>(*p) | 0x20) - 'a' + 10;
+            if (digit < 10 || digit > 15) {
+                break;
+            }
+        }
+        addr = (addr << 4) | digit;
+    }
     res_inst.addr_raw = addr;
+    return _SetInstOp(res_inst, line, end);
+}
+
+inst_t InstructionLoader::_SetInstOp(inst_t &inst, const char *line,
+                                     const char *end) {
     switch (line[0]) {
     case 'l':
-        res_inst.op = I_LOAD;
+        inst.op = I_LOAD;
         break;
     case 's':
-        res_inst.op = I_STORE;
-        break;
-    case '\0':
-        res_inst.op = I_NONE;
+        inst.op = I_STORE;
         break;
     default:
         std::cerr << "Undefined instruction type." << std::endl;
-        std::cerr << "Error line: " << line << std::endl;
+        std::cerr << "Error line: " << std::string(line, end) << std::endl;
+        exit(-1);
+    }
+    return inst;
+}
+
+inst_t InstructionLoader::_ParseRecordToInst(const char *record) {
+    inst_t res_inst;
+    res_inst.addr_raw = 0;
+    std::memcpy(&res_inst.addr_raw, record + 1, _addr_width / 8);
+    switch (record[0]) {
+    case I_LOAD:
+        res_inst.op = I_LOAD;
+        break;
+    case I_STORE:
+        res_inst.op = I_STORE;
+        break;
+    default:
+        std::cerr << "Undefined instruction type in binary trace record "
+                  << (record - _map_begin - sizeof(TraceHeader)) / _record_size
+                  << std::endl;
         exit(-1);
     }
     return res_inst;
@@ -2,7 +2,13 @@
 #define _LOADER_HPP_
 
 #include "datatype.hpp"
+#include "trace_format.hpp"
 #include <memory>
+#include <span>
+
+// Default number of instructions decoded by each GetNextBatch() call
+const ulint INST_BATCH_SIZE = 4096;
+
 class InstructionLoader {
   public:
     explicit InstructionLoader(const std::string &filename);
@@ -10,11 +16,31 @@ class InstructionLoader {
     ~InstructionLoader();
     void LoadTraceFile(const std::string &filename);
     inst_t GetNextInst();
+    // Decode up to batch.size() instructions into batch, returns the number
+    // of decoded instructions, 0 once the trace is exhausted
+    ulint GetNextBatch(std::span<inst_t> batch);
     bool IfAvailable();
 
   private:
-    inst_t _ParseLineToInst(const char *line);
+    bool _MapTraceFile(const std::string &filename);
+    void _UnmapTraceFile();
+    inst_t _ParseMappedLine();
+    inst_t _ParseLineToInst(const char *line, const char *end);
+    inst_t _SetInstOp(inst_t &inst, const char *line, const char *end);
+    inst_t _ParseRecordToInst(const char *record);
     std::unique_ptr<std::ifstream> in_file;
+
+    // Regular files are memory-mapped and parsed in place, other inputs
+    // (pipes, character devices) are read through in_file
+    const char *_map_begin = nullptr;
+    const char *_map_cursor = nullptr;
+    const char *_map_end = nullptr;
+    size_t _map_size = 0;
+
+    // Binary traces (see trace_format.hpp), only read when mapped
+    bool _is_binary = false;
+    uint16_t _addr_width = 0;
+    size_t _record_size = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
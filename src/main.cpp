@@ -4,9 +4,27 @@
 int main(int argc, char **argv) {
     ArgumentParser parser("Argument parser");
     parser.add_argument("-t", "Program trace file", true);
-    parser.add_argument("-c", "Cache config file", true);
+    parser.add_argument("-c", "Cache config file(s)", true);
     parser.add_argument("-q", "--one-line", "Only output one-line hit rate",
                         false);
+    parser.add_argument("-p", "--prefetch",
+                        "Decode trace on a background thread", false);
+    parser.add_argument("-j", "--threads",
+                        "# of threads simulating config files", false);
+    parser.add_argument("-s", "--shards",
+                        "# of threads splitting the sets of a cache", false);
+    parser.add_argument("-m", "--mode",
+                        "cache (default), mrc (LRU miss-ratio curve), "
+                        "allassoc (LRU hit rate of all sets and ways) or "
+                        "shards (sampled LRU miss-ratio curve)",
+                        false);
+    parser.add_argument("-r", "--sample-rate",
+                        "Sampling rate of shards mode (default 0.01)", false);
+    parser.add_argument("-n", "--sample-size",
+                        "Max # of sampled blocks of shards mode", false);
+    parser.add_argument("-S", "--seed",
+                        "Seed of random replacement, overrides config files",
+                        false);
 
     try {
         parser.parse(argc, argv);
@@ -20,14 +38,62 @@ int main(int argc, char **argv) {
         return 0;
     }
 
-    std::string config_path = parser.get<std::string>("c");
     std::string trace_path = parser.get<std::string>("t");
-    std::vector<CacheProperty> cache_setting_list;
 
-    bool is_multi_level(false);
-    ParseCacheConfig(config_path.c_str(), cache_setting_list, is_multi_level);
+    // Every config file is one cache hierarchy, all of them are simulated
+    // by a single pass over the trace
+    std::vector<HierarchyConfig> hierarchy_list;
+    for (auto &config_path : parser.getv<std::string>("c")) {
+        HierarchyConfig hierarchy;
+        hierarchy.name = config_path;
+        ParseCacheConfig(config_path.c_str(), hierarchy.cache_list,
+                         hierarchy.multi_level);
+        if (parser.exists("seed")) {
+            for (auto &_cache : hierarchy.cache_list) {
+                _cache._seed = parser.get<ulint>("seed");
+            }
+        }
+        hierarchy_list.push_back(hierarchy);
+    }
+
+    SimulatorOption option;
+    if (parser.exists("mode")) {
+        std::string mode = parser.get<std::string>("mode");
+        if (mode == "cache") {
+            option.mode = cache_mode;
+        } else if (mode == "mrc") {
+            option.mode = mrc_mode;
+        } else if (mode == "allassoc") {
+            option.mode = allassoc_mode;
+        } else if (mode == "shards") {
+            option.mode = shards_mode;
+        } else {
+            std::cerr << "Unknown simulation mode: " << mode << std::endl;
+            return -1;
+        }
+    }
+    option.prefetch = parser.exists("prefetch");
+    if (parser.exists("threads")) {
+        option.num_thread = std::max(parser.get<ulint>("threads"), ulint(1));
+    }
+    if (parser.exists("shards")) {
+        option.num_shard = std::max(parser.get<ulint>("shards"), ulint(1));
+    }
+    if (parser.exists("sample-size")) {
+        // The fixed-size variant starts from every block and lowers the
+        // rate as needed, unless an initial rate is given
+        option.sample_size = parser.get<ulint>("sample-size");
+        option.sample_rate = 1.0;
+    }
+    if (parser.exists("sample-rate")) {
+        option.sample_rate = parser.get<double>("sample-rate");
+        if (!(option.sample_rate > 0.0 && option.sample_rate <= 1.0)) {
+            std::cerr << "Sampling rate must be in (0, 1]" << std::endl;
+            return -1;
+        }
+    }
 
-    Simulator simulator(cache_setting_list, trace_path, is_multi_level);
+    Simulator simulator(hierarchy_list, trace_path, option);
     simulator.RunSimulation();
 
     if (parser.exists("one-line")) {
@@ -1,265 +1,136 @@
 #include "main_cache.hpp"
-
-MainCache::MainCache(const CacheProperty &setting) : BaseCache(setting) {
-    property._num_block = (setting._cache_size << 10) / setting._block_size;
-
-    switch (property.associativity) {
-    case full_associative:
-        /* For fully associative, remaining bits are used for TAG*/
-        property._bit_index = 0;
-        property._bit_set = 0;
-        property._bit_tag = 32 - property._bit_offset;
-        break;
-    case direct_mapped:
-        property._bit_index = log2l(property._num_block);
-        property._bit_set = 0;
-        property._bit_tag = 32 - property._bit_offset - property._bit_index;
-        break;
-    case set_associative:
-        property._bit_index = 0;
-        property._num_way = setting._num_way;
-        property._num_set = property._num_block / property._num_way;
-        property._bit_set = log2l(property._num_set);
-        property._bit_tag = 32 - property._bit_offset - property._bit_set;
-        break;
-    }
-}
-
-MainCache::~MainCache() = default;
-
-bool MainCache::Get(const addr_t &addr) {
-    bool res = IsHit(addr);
-    if (res) {
-        _HitHandle(addr);
-    }
-    return res;
-}
-
-bool MainCache::Set(const addr_t &addr) {
-    _Replace(addr);
-    _HitHandle(addr);
-    return true;
+#include "arc_replacement.hpp"
+#include "lirs_replacement.hpp"
+#include "predictor_replacement.hpp"
+#include "two_queue_replacement.hpp"
+
+template <typename Tag, ulint Ways, typename Policy>
+MainCache<Tag, Ways, Policy>::MainCache(const CacheProperty &setting)
+    : BaseCache(setting), _cache(property._num_block),
+      _policy(static_cast<Policy *>(_replacement.get())) {}
+
+template <typename Tag, ulint Ways, typename Policy>
+MainCache<Tag, Ways, Policy>::~MainCache() = default;
+
+template <typename Tag, ulint Ways, typename Policy>
+bool MainCache<Tag, Ways, Policy>::IsHit(const addr_t &addr) {
+    // Only the lines of the corresponding set are searched, i.e. the only
+    // one block for direct-mapped and all blocks for fully-associative
+    ulint first = _GetSetNumber(addr) * _NumWay();
+    return _cache.Find(first, first + _NumWay(), _GetTag(addr)) !=
+           first + _NumWay();
 }
 
-bool MainCache::IsHit(const addr_t &addr) {
-    ulint idx(0);
-    bool identical(true);
-
-    auto check_ident = [](const ulint &idx, const uint &_bit_tag,
-                          const addr_t &lhs, const addr_t rhs[]) -> bool {
-        for (uint j = 31, k = 28; j > (31 - _bit_tag); j--, k--) {
-            if (lhs[j] != rhs[idx][k]) {
-                return false;
-            }
-        }
-        return true;
-    };
-
-    switch (property.associativity) {
-    case full_associative:
-        // Fully-Associative: search all cache block
-        for (idx = 0; idx < property._num_block; idx++) {
-            if (_cache[idx][30]) {
-                identical = check_ident(idx, property._bit_tag, addr, _cache);
-                if (identical == true) {
-                    return true;
-                }
-            }
-        }
-        break;
-
-    case direct_mapped:
-        // Directed Mapped: check the only one corresponding block
-        idx = (addr.to_ulong() >> property._bit_offset) % property._num_block;
-        if (_cache[idx][30]) {
-            return check_ident(idx, property._bit_tag, addr, _cache);
+template <typename Tag, ulint Ways, typename Policy>
+void MainCache<Tag, Ways, Policy>::Access(std::span<const inst_t> batch,
+                                          std::vector<inst_t> &misses) {
+    for (const inst_t &inst : batch) {
+        if (inst.op == I_NONE) {
+            continue;
         }
-        break;
-
-    case set_associative:
-        // Set Associative: Get set, then check blocks among the set
-        ulint _set_num = _GetSetNumber(addr);
-        for (idx = _set_num * property._num_way;
-             idx < (_set_num + 1) * property._num_way; idx++) {
-            if (_cache[idx][30]) {
-                identical = check_ident(idx, property._bit_tag, addr, _cache);
-                if (identical == true) {
-                    return true;
-                }
-            }
+        if (!_Lookup(inst.addr_raw)) {
+            _Replace(inst.addr_raw);
+            misses.push_back(inst);
         }
-        break;
     }
-
-    return false;
 }
 
-void MainCache::_Replace(const addr_t &addr) {
-    ulint idx = _GetCacheBlockIndex(addr);
-
-    for (uint j = 31, k = 28; j > (31 - property._bit_tag); j--, k--) {
-        _cache[idx][k] = addr[j];
+template <typename Tag, ulint Ways, typename Policy>
+inline bool MainCache<Tag, Ways, Policy>::_Lookup(const addr_t &addr) {
+    ulint _set_num = _GetSetNumber(addr);
+    ulint first = _set_num * _NumWay();
+    ulint idx = _cache.Find(first, first + _NumWay(), _GetTag(addr));
+    if (idx == first + _NumWay()) {
+        return false;
     }
-    _cache[idx][30] = true;
-}
-
-void MainCache::_HitHandle([[maybe_unused]] const addr_t &addr) {
-    // # TODO
-    auto check_ident = [](const ulint &idx, const uint &_bit_tag,
-                          const addr_t &lhs, const addr_t rhs[]) -> bool {
-        for (uint j = 31, k = 28; j > (31 - _bit_tag); j--, k--) {
-            if (lhs[j] != rhs[idx][k]) {
-                return false;
-            }
-        }
-        return true;
-    };
-
-    switch (property.associativity) {
-
-    case direct_mapped:
-        // Nothing to do
-        break;
-
-    case full_associative:
-        for (ulint idx = 0; idx < property._num_block; idx++) {
-            if (_cache[idx][30] &&
-                check_ident(idx, property._bit_tag, addr, _cache)) {
-                for (ulint j = 0; j < _LRU_priority.size(); j++) {
-                    if (_LRU_priority[j] == idx) {
-                        _LRU_priority.erase(_LRU_priority.begin() + j);
-                        break;
-                    }
-                }
-                _LRU_priority.push_back(idx);
-                break;
-            }
-        }
-
-        break;
-
-    case set_associative:
-        ulint _set_num = _GetSetNumber(addr);
-
-        for (ulint idx = _set_num * property._num_way;
-             idx < (_set_num + 1) * property._num_way; idx++) {
-            if (_cache[idx][30] &&
-                check_ident(idx, property._bit_tag, addr, _cache)) {
-                for (ulint j = 0; j < _LRU_priority.size(); j++) {
-                    if (_LRU_priority[j] == idx) {
-                        _LRU_priority.erase(_LRU_priority.begin() + j);
-                        break;
-                    }
-                }
-                _LRU_priority.push_back(idx);
-                break;
-            }
-        }
-
-        break;
+    if constexpr (Ways != 1) {
+        _policy->Hit(_set_num, idx - first);
     }
+    return true;
 }
 
-ulint MainCache::_GetCacheBlockIndex(const addr_t &addr) {
-    ulint res(0);
-    if (property.associativity == direct_mapped)
-        res = (addr.to_ulong() >> property._bit_offset) % property._num_block;
-    else {
-        switch (property.replacement_policy) {
-        case RANDOM:
-            res = _GetIndexByRandom(addr);
-            break;
-        case LRU:
-            res = _GetIndexByLRU(addr);
-            break;
-        default:
-            std::cerr << "Invalid replacement policy" << std::endl;
-            break;
-        }
+template <typename Tag, ulint Ways, typename Policy>
+inline void MainCache<Tag, Ways, Policy>::_Replace(const addr_t &addr) {
+    ulint _set_num = _GetSetNumber(addr);
+    addr_t block = addr >> property._bit_offset;
+    // Direct-mapped caches have only one block in each set
+    ulint way(0);
+    if constexpr (Ways != 1) {
+        way = _policy->GetVictim(_set_num, block);
+    }
+    _cache.Fill(_set_num * _NumWay() + way, _GetTag(addr));
+    if constexpr (Ways != 1) {
+        _policy->Fill(_set_num, way, block);
     }
-
-    return res;
 }
 
-ulint MainCache::_GetIndexByRandom(const addr_t &addr) {
-    std::random_device rd;
-    std::mt19937_64 generator(rd());
-    std::uniform_int_distribution<int> unif(0, INT32_MAX);
-    ulint res(0);
-    switch (property.associativity) {
-    case direct_mapped:
-        // nothing to do
-        break;
-
-    case full_associative:
-        res = static_cast<ulint>(unif(generator) /
-                                 (INT32_MAX / property._num_block + 1));
-        break;
-
-    case set_associative:
-        ulint temp = static_cast<ulint>(unif(generator) /
-                                        (INT32_MAX / property._num_way + 1));
-        ulint _set_num = _GetSetNumber(addr);
-        res = _set_num * property._num_way + temp;
-        break;
+template <typename Tag, typename Policy>
+static std::unique_ptr<BaseCache> _MakeCache(const CacheProperty &setting,
+                                             const ulint &ways) {
+    switch (ways) {
+    case 1:
+        return std::make_unique<MainCache<Tag, 1, Policy>>(setting);
+    case 2:
+        return std::make_unique<MainCache<Tag, 2, Policy>>(setting);
+    case 4:
+        return std::make_unique<MainCache<Tag, 4, Policy>>(setting);
+    case 8:
+        return std::make_unique<MainCache<Tag, 8, Policy>>(setting);
+    case 16:
+        return std::make_unique<MainCache<Tag, 16, Policy>>(setting);
+    default:
+        return std::make_unique<MainCache<Tag, 0, Policy>>(setting);
     }
-
-    return res;
 }
 
-ulint MainCache::_GetIndexByLRU([[maybe_unused]] const addr_t &addr) {
-    ulint res(0);
-    // # TODO
-
-    switch (property.associativity) {
-    case direct_mapped:
-        break;
-
-    case full_associative:
-        for (ulint idx = 0; idx < property._num_block; idx++) {
-            if (!_cache[idx][30]) {
-                return idx;
-            }
-        }
-        res = _LRU_priority.front();
-        // std::cout << "after" << std::endl;
-        _LRU_priority.erase(_LRU_priority.begin());
-
-        break;
-
-    case set_associative:
-        ulint _set_num = _GetSetNumber(addr);
-        for (ulint idx = _set_num * property._num_way;
-             idx < (_set_num + 1) * property._num_way; idx++) {
-            if (!_cache[idx][30]) {
-                return idx;
-            }
-        }
-
-        bool flag(false);
-        ulint j;
-        for (j = 0; j < _LRU_priority.size() && !flag; j++) {
-            for (ulint idx = _set_num * property._num_way;
-                 idx < (_set_num + 1) * property._num_way && !flag; idx++) {
-                if (_LRU_priority[j] == idx) {
-                    flag = true;
-                    res = _LRU_priority[j];
-                    _LRU_priority.erase(_LRU_priority.begin() + j);
-                }
-            }
-        }
-
-        break;
+template <typename Tag>
+static std::unique_ptr<BaseCache> _MakeCache(const CacheProperty &setting,
+                                             const CacheProperty &property) {
+    if (property.associativity == direct_mapped) {
+        return _MakeCache<Tag, BaseReplacement>(setting, 1);
+    }
+    ulint ways = property.associativity == full_associative
+                     ? property._num_block
+                     : property._num_way;
+    switch (property.replacement_policy) {
+    case LRU:
+        return _MakeCache<Tag, LRUReplacement>(setting, ways);
+    case PLRU:
+        return _MakeCache<Tag, PLRUReplacement>(setting, ways);
+    case CLOCK:
+        return _MakeCache<Tag, ClockReplacement>(setting, ways);
+    case NRU:
+        return _MakeCache<Tag, NRUReplacement>(setting, ways);
+    case SRRIP:
+    case BRRIP:
+    case DRRIP:
+        return _MakeCache<Tag, RRIPReplacement>(setting, ways);
+    case OPT:
+        return _MakeCache<Tag, OPTReplacement>(setting, ways);
+    case ARC:
+    case CAR:
+        return _MakeCache<Tag, ARCReplacement>(setting, ways);
+    case LIRS:
+        return _MakeCache<Tag, LIRSReplacement>(setting, ways);
+    case TWOQ:
+        return _MakeCache<Tag, TwoQueueReplacement>(setting, ways);
+    case SHIP:
+        return _MakeCache<Tag, SHiPReplacement>(setting, ways);
+    case HAWKEYE:
+        return _MakeCache<Tag, HawkeyeReplacement>(setting, ways);
+    case RANDOM:
+        return _MakeCache<Tag, RandomReplacement>(setting, ways);
+    default:
+        return _MakeCache<Tag, BaseReplacement>(setting, ways);
     }
-
-    return res;
 }
 
-ulint MainCache::_GetSetNumber(const addr_t &addr) {
-    std::bitset<28> _set_num;
-    for (ulint i = (property._bit_offset), j = 0;
-         i < (property._bit_offset + property._bit_set); ++i, ++j) {
-        _set_num[j] = addr[i];
+std::unique_ptr<BaseCache> MakeCache(const CacheProperty &setting) {
+    // Up to 32 tag bits keep the 32-bit tag store and compare kernels
+    CacheProperty property = setting;
+    ResolveCacheGeometry(property);
+    if (property._bit_tag <= 32) {
+        return _MakeCache<tag_t>(setting, property);
     }
-    return _set_num.to_ulong();
+    return _MakeCache<wide_tag_t>(setting, property);
 }
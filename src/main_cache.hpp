@@ -2,25 +2,44 @@
 #define _MAIN_CACHE_HPP_
 
 #include "base_cache.hpp"
-#include <random>
+#include "tag_store.hpp"
 
-class MainCache : public BaseCache {
+/*
+    Tag is tag_t or wide_tag_t. Ways is the associativity when it is known
+    at compile time (1 for direct-mapped), or 0 to read it from _set_ways.
+    Policy is the final replacement class the cache is built with, so its
+    calls are not virtual, or BaseReplacement for any other policy.
+    MakeCache() picks the instantiation matching a configuration.
+*/
+template <typename Tag, ulint Ways, typename Policy>
+class MainCache final : public BaseCache {
   public:
     explicit MainCache(const CacheProperty &);
     ~MainCache();
-    bool Get(const addr_t &);
-    bool Set(const addr_t &);
+    bool Get(const addr_t &addr) { return _Lookup(addr); }
+    bool Set(const addr_t &addr) {
+        _Replace(addr);
+        return true;
+    }
     bool IsHit(const addr_t &);
+    void Access(std::span<const inst_t> batch, std::vector<inst_t> &misses);
 
   protected:
-    void _HitHandle(const addr_t &);
+    ulint _NumWay() const { return Ways != 0 ? Ways : _set_ways; }
+    bool _Lookup(const addr_t &addr);
     void _Replace(const addr_t &);
-    ulint _GetCacheBlockIndex(const addr_t &addr);
-    ulint _GetIndexByLRU(const addr_t &addr);
-    ulint _GetIndexByRandom(const addr_t &addr);
-    ulint _GetSetNumber(const addr_t &addr);
+    Tag _GetTag(const addr_t &addr) {
+        return static_cast<Tag>(addr >> _tag_shift);
+    }
 
-    std::vector<ulint> _LRU_priority;
+    // Tags and valid bits of every cache line
+    TagStore<Tag> _cache;
+    // _replacement as its concrete type, null for direct-mapped caches
+    Policy *_policy;
 };
 
-#endif
\ No newline at end of file
+// Cache with the narrowest tag store and the most specialized lookup for
+// the configuration
+std::unique_ptr<BaseCache> MakeCache(const CacheProperty &setting);
+
+#endif
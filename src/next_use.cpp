@@ -0,0 +1,42 @@
+#include "next_use.hpp"
+#include "loader.hpp"
+#include <filesystem>
+#include <unordered_map>
+
+NextUseIndex::NextUseIndex(const std::string &trace_file,
+                           const ulint &bit_offset) {
+    // A pipe could not be read again by the simulation itself
+    if (!std::filesystem::is_regular_file(trace_file)) {
+        std::cerr << "OPT replacement needs a regular trace file"
+                  << std::endl;
+        exit(-1);
+    }
+
+    // Each access fills in the next use of the previous access to its block,
+    // which gives the same index as a backward pass without keeping the
+    // block of every access
+    InstructionLoader loader(trace_file);
+    std::vector<inst_t> batch(INST_BATCH_SIZE);
+    std::unordered_map<addr_raw_t, uint32_t> last_access;
+    for (ulint n = loader.GetNextBatch(batch); n != 0;
+         n = loader.GetNextBatch(batch)) {
+        for (ulint i = 0; i < n; i++) {
+            if (batch[i].op == I_NONE) {
+                continue;
+            }
+            if (_next_use.size() >= NEVER_REUSED) {
+                std::cerr << "Trace too long for OPT replacement"
+                          << std::endl;
+                exit(-1);
+            }
+            uint32_t pos = _next_use.size();
+            auto [it, is_new] =
+                last_access.try_emplace(batch[i].addr_raw >> bit_offset, pos);
+            if (!is_new) {
+                _next_use[it->second] = pos;
+                it->second = pos;
+            }
+            _next_use.push_back(NEVER_REUSED);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef _NEXT_USE_HPP_
+#define _NEXT_USE_HPP_
+
+#include "datatype.hpp"
+#include <vector>
+
+// Next use of an access whose block is never accessed again
+const uint32_t NEVER_REUSED = UINT32_MAX - 1;
+
+/*
+    Future knowledge for offline-optimal replacement: for the i-th load or
+    store of a trace, the position of the next access to the same block.
+    Built by one extra pass over the trace file, 4 bytes per access.
+*/
+class NextUseIndex {
+  public:
+    explicit NextUseIndex(const std::string &trace_file,
+                          const ulint &bit_offset);
+
+    uint32_t GetNextUse(const ulint &pos) const { return _next_use[pos]; }
+    ulint GetNumAccess() const { return _next_use.size(); }
+
+  private:
+    std::vector<uint32_t> _next_use;
+};
+
+#endif
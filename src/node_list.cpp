@@ -0,0 +1,53 @@
+#include "node_list.hpp"
+
+NodeLists::NodeLists(const ulint &num_node, const ulint &num_list)
+    : _list(num_list, {NO_NODE, NO_NODE, 0}), _prev(num_node, NO_NODE),
+      _next(num_node, NO_NODE), _owner(num_node, num_list) {}
+
+void NodeLists::PushTail(const uint8_t &list, const uint32_t &node) {
+    _List &l = _list[list];
+    _prev[node] = l.tail;
+    _next[node] = NO_NODE;
+    if (l.tail != NO_NODE) {
+        _next[l.tail] = node;
+    } else {
+        l.head = node;
+    }
+    l.tail = node;
+    ++l.size;
+    _owner[node] = list;
+}
+
+void NodeLists::Remove(const uint32_t &node) {
+    _List &l = _list[_owner[node]];
+    if (_prev[node] != NO_NODE) {
+        _next[_prev[node]] = _next[node];
+    } else {
+        l.head = _next[node];
+    }
+    if (_next[node] != NO_NODE) {
+        _prev[_next[node]] = _prev[node];
+    } else {
+        l.tail = _prev[node];
+    }
+    --l.size;
+    _owner[node] = _list.size();
+}
+
+void NodeLists::Replace(const uint32_t &old, const uint32_t &node) {
+    _List &l = _list[_owner[old]];
+    _prev[node] = _prev[old];
+    _next[node] = _next[old];
+    if (_prev[node] != NO_NODE) {
+        _next[_prev[node]] = node;
+    } else {
+        l.head = node;
+    }
+    if (_next[node] != NO_NODE) {
+        _prev[_next[node]] = node;
+    } else {
+        l.tail = node;
+    }
+    _owner[node] = _owner[old];
+    _owner[old] = _list.size();
+}
@@ -0,0 +1,44 @@
+#ifndef _NODE_LIST_HPP_
+#define _NODE_LIST_HPP_
+
+#include "datatype.hpp"
+#include <vector>
+
+// End of a list, or no node
+const uint32_t NO_NODE = UINT32_MAX;
+
+/*
+    A fixed number of intrusive doubly-linked lists over a fixed array of
+    nodes, each node in at most one of them at a time. Replacement policies
+    with a history of non-resident blocks keep their ways and ghost entries
+    as nodes, so moving a block between lists costs O(1) and allocates
+    nothing. The head of a list is its oldest node, the tail its newest.
+*/
+class NodeLists {
+  public:
+    explicit NodeLists(const ulint &num_node, const ulint &num_list);
+
+    uint32_t Head(const uint8_t &list) const { return _list[list].head; }
+    ulint Size(const uint8_t &list) const { return _list[list].size; }
+    // List holding the node, the number of lists if none
+    uint8_t Owner(const uint32_t &node) const { return _owner[node]; }
+
+    void PushTail(const uint8_t &list, const uint32_t &node);
+    void Remove(const uint32_t &node);
+    // Put node in place of old, which leaves its list
+    void Replace(const uint32_t &old, const uint32_t &node);
+
+  private:
+    struct _List {
+        uint32_t head;
+        uint32_t tail;
+        ulint size;
+    };
+
+    std::vector<_List> _list;
+    std::vector<uint32_t> _prev;
+    std::vector<uint32_t> _next;
+    std::vector<uint8_t> _owner;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "predictor_replacement.hpp"
+#include <algorithm>
+
+SHiPReplacement::SHiPReplacement(const ulint &num_set, const ulint &num_way,
+                                 const ulint &rrpv_bits,
+                                 const ulint &bit_offset)
+    : BaseReplacement(num_set, num_way), _hash(bit_offset),
+      _max_rrpv((1 << rrpv_bits) - 1), _shct(1 << SIGNATURE_BITS, 1),
+      _signature(num_set * num_way, 0), _reused(num_set * num_way, 1) {
+    // Lines start distant, so empty ways are filled first, and count as
+    // reused, so their eviction trains nothing
+    _rrpv.assign(num_set * num_way, _max_rrpv);
+}
+
+void SHiPReplacement::Fill(const ulint &set, const ulint &way,
+                           const addr_t &block) {
+    ulint line = set * _num_way + way;
+    uint16_t signature = _hash(block);
+    _signature[line] = signature;
+    _reused[line] = 0;
+    _rrpv[line] = _shct[signature] == 0 ? _max_rrpv : _max_rrpv - 1;
+}
+
+ulint SHiPReplacement::GetVictim(const ulint &set, const addr_t &) {
+    ulint victim =
+        AgeToRRIPVictim(&_rrpv[set * _num_way], _num_way, _max_rrpv);
+    ulint line = set * _num_way + victim;
+    if (!_reused[line]) {
+        uint8_t &counter = _shct[_signature[line]];
+        counter -= counter > 0;
+    }
+    return victim;
+}
+
+HawkeyeReplacement::HawkeyeReplacement(const ulint &num_set,
+                                       const ulint &num_way,
+                                       const ulint &bit_offset)
+    : BaseReplacement(num_set, num_way), _hash(bit_offset),
+      _predictor(1 << SIGNATURE_BITS, (PREDICTOR_COUNTER_MAX + 1) / 2),
+      _rrpv(num_set * num_way, HAWKEYE_MAX_RRPV),
+      _signature(num_set * num_way, 0),
+      _sample_stride(std::max<ulint>(1, num_set / HAWKEYE_NUM_SAMPLE)),
+      _history_length(HAWKEYE_HISTORY_PER_WAY * num_way) {
+    ulint num_slot = (num_set + _sample_stride - 1) / _sample_stride;
+    _sample_block.assign(num_slot * num_way, 0);
+    _time.assign(num_slot, 0);
+    _occupancy.assign(num_slot * _history_length, 0);
+}
+
+void HawkeyeReplacement::Hit(const ulint &set, const ulint &way) {
+    ulint line = set * _num_way + way;
+    if (set % _sample_stride == 0) {
+        ulint slot = set / _sample_stride;
+        _Train(slot, _sample_block[slot * _num_way + way], _signature[line]);
+    }
+    _rrpv[line] = _IsFriendly(_signature[line]) ? 0 : HAWKEYE_MAX_RRPV;
+}
+
+void HawkeyeReplacement::Fill(const ulint &set, const ulint &way,
+                              const addr_t &block) {
+    ulint line = set * _num_way + way;
+    uint16_t signature = _hash(block);
+    _signature[line] = signature;
+    if (set % _sample_stride == 0) {
+        ulint slot = set / _sample_stride;
+        _sample_block[slot * _num_way + way] = block;
+        _Train(slot, block, signature);
+    }
+    if (!_IsFriendly(signature)) {
+        _rrpv[line] = HAWKEYE_MAX_RRPV;
+        return;
+    }
+
+    // Age the other friendly lines, unless one of them is already the
+    // oldest a friendly line can be
+    uint8_t *rrpv = &_rrpv[set * _num_way];
+    if (std::find(rrpv, rrpv + _num_way, HAWKEYE_MAX_RRPV - 1) ==
+        rrpv + _num_way) {
+        for (ulint w = 0; w < _num_way; w++) {
+            rrpv[w] += rrpv[w] < HAWKEYE_MAX_RRPV - 1;
+        }
+    }
+    rrpv[way] = 0;
+}
+
+ulint HawkeyeReplacement::GetVictim(const ulint &set, const addr_t &) {
+    const uint8_t *rrpv = &_rrpv[set * _num_way];
+    ulint victim(0);
+    for (ulint way = 1; way < _num_way && rrpv[victim] < HAWKEYE_MAX_RRPV;
+         way++) {
+        if (rrpv[way] > rrpv[victim]) {
+            victim = way;
+        }
+    }
+    // No averse line, the predictor was wrong about the oldest friendly one
+    if (rrpv[victim] < HAWKEYE_MAX_RRPV && set % _sample_stride == 0) {
+        uint8_t &counter = _predictor[_signature[set * _num_way + victim]];
+        counter -= counter > 0;
+    }
+    return victim;
+}
+
+void HawkeyeReplacement::_Train(const ulint &slot, const addr_t &block,
+                                const uint16_t &signature) {
+    uint64_t now = _time[slot]++;
+    uint32_t *occupancy = &_occupancy[slot * _history_length];
+    // The entry of the access _history_length ago is reused for this one
+    occupancy[now % _history_length] = 0;
+
+    auto it = _history.find(block);
+    if (it == _history.end()) {
+        if (_history.size() >= 2 * _time.size() * _history_length) {
+            _PurgeHistory();
+        }
+        _history.emplace(
+            block, _LastAccess{now, static_cast<uint32_t>(slot), signature});
+        return;
+    }
+
+    // OPT keeps the block since its last access if there was room at every
+    // access in between, older accesses are out of the history
+    _LastAccess &last = it->second;
+    bool keep = now - last.time < _history_length;
+    for (uint64_t t = last.time; keep && t < now; t++) {
+        keep = occupancy[t % _history_length] < _num_way;
+    }
+    if (keep) {
+        for (uint64_t t = last.time; t < now; t++) {
+            ++occupancy[t % _history_length];
+        }
+    }
+    uint8_t &counter = _predictor[last.signature];
+    if (keep) {
+        counter += counter < PREDICTOR_COUNTER_MAX;
+    } else {
+        counter -= counter > 0;
+    }
+    last.time = now;
+    last.signature = signature;
+}
+
+void HawkeyeReplacement::_PurgeHistory() {
+    for (auto it = _history.begin(); it != _history.end();) {
+        if (_time[it->second.slot] - it->second.time >= _history_length) {
+            it = _history.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef _PREDICTOR_REPLACEMENT_HPP_
+#define _PREDICTOR_REPLACEMENT_HPP_
+
+#include "replacement.hpp"
+#include <unordered_map>
+
+// Traces have no PC, blocks are classified by the 2^14-byte memory region
+// they belong to (SHiP-Mem), hashed to a signature of 14 bits
+const ulint SIGNATURE_REGION_BITS = 14;
+const ulint SIGNATURE_BITS = 14;
+// Both predictors are tables of 3-bit saturating counters
+const uint8_t PREDICTOR_COUNTER_MAX = 7;
+
+// Hawkeye trains on this many sampled sets, OPTgen looks back over this
+// many accesses per way of a sampled set
+const ulint HAWKEYE_NUM_SAMPLE = 64;
+const ulint HAWKEYE_HISTORY_PER_WAY = 8;
+// Hawkeye uses 3-bit RRPVs
+const uint8_t HAWKEYE_MAX_RRPV = 7;
+
+class RegionSignature {
+  public:
+    explicit RegionSignature(const ulint &bit_offset)
+        : _shift(bit_offset < SIGNATURE_REGION_BITS
+                     ? SIGNATURE_REGION_BITS - bit_offset
+                     : 0) {}
+    uint16_t operator()(const addr_t &block) const {
+        // Fibonacci hashing of the region number
+        return ((block >> _shift) * 0x9e3779b97f4a7c15ULL) >>
+               (64 - SIGNATURE_BITS);
+    }
+
+  private:
+    ulint _shift; // block address to region number
+};
+
+/*
+    SHiP (Wu et al., MICRO 2011) over SRRIP. The signature history counter
+    table (SHCT) learns which signatures fill lines that are reused: a hit
+    increments the counter of the line's signature, evicting a line never
+    reused decrements it. Fills whose signature counter is 0 are predicted
+    distant, the others long as in SRRIP.
+*/
+class SHiPReplacement final : public BaseReplacement {
+  public:
+    explicit SHiPReplacement(const ulint &num_set, const ulint &num_way,
+                             const ulint &rrpv_bits, const ulint &bit_offset);
+    void Hit(const ulint &set, const ulint &way) {
+        ulint line = set * _num_way + way;
+        _rrpv[line] = 0;
+        _reused[line] = 1;
+        uint8_t &counter = _shct[_signature[line]];
+        counter += counter < PREDICTOR_COUNTER_MAX;
+    }
+    void Fill(const ulint &set, const ulint &way, const addr_t &block);
+    ulint GetVictim(const ulint &set, const addr_t &);
+    // The SHCT is shared by all sets
+    bool IsSetLocal() const { return false; }
+
+  private:
+    RegionSignature _hash;
+    uint8_t _max_rrpv;
+    std::vector<uint8_t> _shct;
+    // Per line, indexed by set * ways + way
+    std::vector<uint8_t> _rrpv;
+    std::vector<uint16_t> _signature;
+    std::vector<uint8_t> _reused; // hit since its fill
+};
+
+/*
+    Hawkeye (Jain and Lin, ISCA 2016) with region signatures. OPTgen replays
+    the accesses of sampled sets to find whether Belady's OPT would have
+    kept each block since its previous access: it would if, at every access
+    of the set in between, fewer blocks than ways were kept for their next
+    use. The predictor counter of the signature of that previous access
+    learns the answer. Lines whose signature is predicted cache-averse are
+    inserted with a distant RRPV and evicted first; cache-friendly lines
+    age with each friendly fill and the oldest is evicted, training its
+    signature negatively in the sampled sets.
+*/
+class HawkeyeReplacement final : public BaseReplacement {
+  public:
+    explicit HawkeyeReplacement(const ulint &num_set, const ulint &num_way,
+                                const ulint &bit_offset);
+    void Hit(const ulint &set, const ulint &way);
+    void Fill(const ulint &set, const ulint &way, const addr_t &block);
+    ulint GetVictim(const ulint &set, const addr_t &);
+    // The predictor is shared by all sets
+    bool IsSetLocal() const { return false; }
+
+  private:
+    // Feed an access of a sampled set to OPTgen
+    void _Train(const ulint &slot, const addr_t &block,
+                const uint16_t &signature);
+    // Forget the blocks last seen before the history of their set
+    void _PurgeHistory();
+    bool _IsFriendly(const uint16_t &signature) const {
+        return _predictor[signature] > PREDICTOR_COUNTER_MAX / 2;
+    }
+
+    RegionSignature _hash;
+    std::vector<uint8_t> _predictor;
+    // Per line, indexed by set * ways + way
+    std::vector<uint8_t> _rrpv;
+    std::vector<uint16_t> _signature;
+
+    // Set s is sampled in slot s / stride if s % stride == 0
+    ulint _sample_stride;
+    ulint _history_length; // # of accesses seen back by OPTgen
+    std::vector<addr_t> _sample_block; // block of each sampled line
+    std::vector<uint64_t> _time;       // # of accesses of each sampled set
+    // # of blocks OPT keeps across each of the last accesses of each
+    // sampled set, circular in _history_length entries
+    std::vector<uint32_t> _occupancy;
+
+    struct _LastAccess {
+        uint64_t time;
+        uint32_t slot;
+        uint16_t signature;
+    };
+    std::unordered_map<addr_t, _LastAccess> _history;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "prefetch_loader.hpp"
+
+PrefetchLoader::PrefetchLoader(InstructionLoader &loader,
+                               const ulint &num_chunk, const ulint &chunk_size)
+    : _loader(loader), _chunk_len(num_chunk, 0), _head(0), _tail(0),
+      _stop(false), _holding(false) {
+    for (ulint i = 0; i < num_chunk; i++) {
+        _chunks.emplace_back(chunk_size);
+    }
+    _reader = std::thread(&PrefetchLoader::_ReaderLoop, this);
+}
+
+PrefetchLoader::~PrefetchLoader() {
+    // Wake the reader up in case it is waiting for a free chunk
+    _stop.store(true, std::memory_order_release);
+    _tail.fetch_add(1, std::memory_order_release);
+    _tail.notify_one();
+    _reader.join();
+}
+
+std::span<const inst_t> PrefetchLoader::GetNextChunk() {
+    ulint tail = _tail.load(std::memory_order_relaxed);
+    if (_holding) {
+        _tail.store(++tail, std::memory_order_release);
+        _tail.notify_one();
+    }
+
+    _head.wait(tail, std::memory_order_acquire);
+    ulint slot = tail % _chunks.size();
+    _holding = (_chunk_len[slot] != 0);
+    return std::span<const inst_t>(_chunks[slot].data(), _chunk_len[slot]);
+}
+
+void PrefetchLoader::_ReaderLoop() {
+    const ulint num_chunk = _chunks.size();
+    for (ulint head = 0;; head++) {
+        // Wait until the consumer has released the chunk to be refilled
+        ulint tail = _tail.load(std::memory_order_acquire);
+        while (head - tail == num_chunk) {
+            _tail.wait(tail, std::memory_order_acquire);
+            tail = _tail.load(std::memory_order_acquire);
+        }
+        if (_stop.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        ulint slot = head % num_chunk;
+        _chunk_len[slot] = _loader.GetNextBatch(_chunks[slot]);
+        _head.store(head + 1, std::memory_order_release);
+        _head.notify_one();
+        if (_chunk_len[slot] == 0) {
+            return;
+        }
+    }
+}
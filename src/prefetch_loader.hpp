@@ -0,0 +1,46 @@
+#ifndef _PREFETCH_LOADER_HPP_
+#define _PREFETCH_LOADER_HPP_
+
+#include "loader.hpp"
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
+
+const ulint PREFETCH_NUM_CHUNK = 4;
+const ulint PREFETCH_CHUNK_SIZE = 65536;
+
+/*
+    Decodes the trace on a background thread into a ring of chunks shared
+    with the consumer thread. The ring is single-producer/single-consumer
+    and lock-free: the reader only advances _head, the consumer only
+    advances _tail, and each side blocks on the other's counter with
+    atomic wait/notify when the ring is full or empty.
+*/
+class PrefetchLoader {
+  public:
+    explicit PrefetchLoader(InstructionLoader &loader,
+                            const ulint &num_chunk = PREFETCH_NUM_CHUNK,
+                            const ulint &chunk_size = PREFETCH_CHUNK_SIZE);
+    ~PrefetchLoader();
+
+    // Next decoded chunk, empty once the trace is exhausted. The chunk
+    // stays valid until the next call.
+    std::span<const inst_t> GetNextChunk();
+
+  private:
+    void _ReaderLoop();
+
+    InstructionLoader &_loader;
+    std::vector<std::vector<inst_t>> _chunks;
+    std::vector<ulint> _chunk_len; // 0 marks the end of the trace
+
+    std::atomic<ulint> _head; // # of chunks filled by the reader
+    std::atomic<ulint> _tail; // # of chunks released by the consumer
+    std::atomic<bool> _stop;  // consumer is gone, reader must quit
+    bool _holding;            // consumer still holds chunk _tail
+
+    std::thread _reader;
+};
+
+#endif
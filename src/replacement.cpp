@@ -0,0 +1,221 @@
+#include "replacement.hpp"
+#include "arc_replacement.hpp"
+#include "lirs_replacement.hpp"
+#include "predictor_replacement.hpp"
+#include "two_queue_replacement.hpp"
+
+BaseReplacement::BaseReplacement(const ulint &num_set, const ulint &num_way)
+    : _num_set(num_set), _num_way(num_way) {}
+
+RandomReplacement::RandomReplacement(const ulint &num_set,
+                                     const ulint &num_way, const ulint &seed)
+    : BaseReplacement(num_set, num_way), _state(num_set) {
+    for (ulint set = 0; set < num_set; set++) {
+        // SplitMix64 of (seed, set), a zero state would stay zero
+        uint64_t z = seed + (set + 1) * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z ^= z >> 31;
+        _state[set] = z != 0 ? z : 1;
+    }
+}
+
+LRUReplacement::LRUReplacement(const ulint &num_set, const ulint &num_way)
+    : BaseReplacement(num_set, num_way), _prev(num_set * num_way),
+      _next(num_set * num_way), _head(num_set, num_way - 1), _tail(num_set, 0) {
+    // Initial order from MRU to LRU: way (N-1), ..., way 1, way 0
+    for (ulint set = 0; set < num_set; set++) {
+        for (ulint way = 0; way < num_way; way++) {
+            _prev[set * num_way + way] = way + 1;
+            _next[set * num_way + way] = way - 1;
+        }
+    }
+}
+
+void LRUReplacement::_MoveToHead(const ulint &set, const ulint &way) {
+    uint32_t head = _head[set];
+    if (head == way) {
+        return;
+    }
+
+    // Unlink the line, it has a predecessor since it is not the head
+    uint32_t *prev = &_prev[set * _num_way];
+    uint32_t *next = &_next[set * _num_way];
+    if (_tail[set] == way) {
+        _tail[set] = prev[way];
+    } else {
+        prev[next[way]] = prev[way];
+    }
+    next[prev[way]] = next[way];
+
+    // Then link it in front of the old head
+    next[way] = head;
+    prev[head] = way;
+    _head[set] = way;
+}
+
+PLRUReplacement::PLRUReplacement(const ulint &num_set, const ulint &num_way)
+    : BaseReplacement(num_set, num_way), _num_word((num_way + 63) / 64),
+      _bits(num_set * _num_word, 0) {
+    if (num_way & (num_way - 1)) {
+        std::cerr << "PLRU replacement needs a power-of-two # of ways"
+                  << std::endl;
+        exit(-1);
+    }
+}
+
+RRIPReplacement::RRIPReplacement(const ReplacePolicies &policy,
+                                 const ulint &num_set, const ulint &num_way,
+                                 const ulint &rrpv_bits)
+    : BaseReplacement(num_set, num_way), _policy(policy),
+      _max_rrpv((1 << rrpv_bits) - 1), _fill_count(num_set, 0),
+      _leader_stride(0), _psel(1 << (DRRIP_PSEL_BITS - 1)) {
+    // Lines start distant, so empty ways are filled first
+    _rrpv.assign(num_set * num_way, _max_rrpv);
+    // Each policy leads one set of every stride, at most a quarter of the
+    // sets, so that at least half of them follow PSEL
+    if (num_set >= DRRIP_MIN_LEADER_STRIDE) {
+        _leader_stride =
+            std::max(DRRIP_MIN_LEADER_STRIDE, num_set / DRRIP_NUM_LEADER);
+    }
+}
+
+void RRIPReplacement::Fill(const ulint &set, const ulint &way,
+                           const addr_t &) {
+    if (_policy == DRRIP && _leader_stride != 0) {
+        // A fill is a miss, leader misses vote for the other policy
+        ulint lead = set % _leader_stride;
+        if (lead == 0 && _psel < (1 << DRRIP_PSEL_BITS) - 1) {
+            ++_psel;
+        } else if (lead == 1 && _psel > 0) {
+            --_psel;
+        }
+    }
+    _rrpv[set * _num_way + way] =
+        _IsBimodal(set) && ++_fill_count[set] % BRRIP_LONG_INTERVAL != 0
+            ? _max_rrpv
+            : _max_rrpv - 1;
+}
+
+ulint RRIPReplacement::GetVictim(const ulint &set, const addr_t &) {
+    return AgeToRRIPVictim(&_rrpv[set * _num_way], _num_way, _max_rrpv);
+}
+
+bool RRIPReplacement::_IsBimodal(const ulint &set) {
+    switch (_policy) {
+    case BRRIP:
+        return true;
+    case DRRIP:
+        if (_leader_stride != 0 && set % _leader_stride < 2) {
+            return set % _leader_stride == 1;
+        }
+        // Followers take BRRIP once SRRIP leaders miss more
+        return _psel > (1 << (DRRIP_PSEL_BITS - 1));
+    default:
+        return false;
+    }
+}
+
+OPTReplacement::OPTReplacement(const ulint &num_set, const ulint &num_way,
+                               std::shared_ptr<const NextUseIndex> next_use)
+    : BaseReplacement(num_set, num_way), _next_use(std::move(next_use)),
+      _time(0), _key(num_set * num_way, UINT32_MAX),
+      _heap(num_set * num_way), _slot(num_set * num_way) {
+    for (ulint line = 0; line < num_set * num_way; line++) {
+        _heap[line] = line % num_way;
+        _slot[line] = line % num_way;
+    }
+}
+
+void OPTReplacement::_Access(const ulint &set, const ulint &way) {
+    if (_time >= _next_use->GetNumAccess()) {
+        std::cerr << "OPT replacement ran past its next-use index"
+                  << std::endl;
+        exit(-1);
+    }
+    uint32_t *key = &_key[set * _num_way];
+    uint32_t *heap = &_heap[set * _num_way];
+    uint32_t *slot = &_slot[set * _num_way];
+    uint32_t next = _next_use->GetNextUse(_time++);
+    uint32_t old = key[way];
+    key[way] = next;
+
+    ulint i = slot[way];
+    if (next > old) {
+        // Sift up towards the root, the furthest next use
+        while (i > 0 && key[heap[(i - 1) / 2]] < next) {
+            heap[i] = heap[(i - 1) / 2];
+            slot[heap[i]] = i;
+            i = (i - 1) / 2;
+        }
+    } else {
+        for (;;) {
+            ulint child = 2 * i + 1;
+            if (child >= _num_way) {
+                break;
+            }
+            if (child + 1 < _num_way &&
+                key[heap[child + 1]] > key[heap[child]]) {
+                ++child;
+            }
+            if (key[heap[child]] <= next) {
+                break;
+            }
+            heap[i] = heap[child];
+            slot[heap[i]] = i;
+            i = child;
+        }
+    }
+    heap[i] = way;
+    slot[way] = i;
+}
+
+std::unique_ptr<BaseReplacement> MakeReplacement(const CacheProperty &property,
+                                                 const ulint &num_set,
+                                                 const ulint &num_way) {
+    switch (property.replacement_policy) {
+    case RANDOM:
+        return std::make_unique<RandomReplacement>(num_set, num_way,
+                                                   property._seed);
+    case LRU:
+        return std::make_unique<LRUReplacement>(num_set, num_way);
+    case PLRU:
+        return std::make_unique<PLRUReplacement>(num_set, num_way);
+    case CLOCK:
+        return std::make_unique<ClockReplacement>(num_set, num_way);
+    case NRU:
+        return std::make_unique<NRUReplacement>(num_set, num_way);
+    case SRRIP:
+    case BRRIP:
+    case DRRIP:
+        return std::make_unique<RRIPReplacement>(
+            property.replacement_policy, num_set, num_way,
+            property._rrpv_bits);
+    case OPT:
+        if (!property._next_use) {
+            std::cerr << "OPT replacement is only supported on the first "
+                         "cache level"
+                      << std::endl;
+            exit(-1);
+        }
+        return std::make_unique<OPTReplacement>(num_set, num_way,
+                                                property._next_use);
+    case ARC:
+    case CAR:
+        return std::make_unique<ARCReplacement>(property.replacement_policy,
+                                                num_set, num_way);
+    case LIRS:
+        return std::make_unique<LIRSReplacement>(num_set, num_way);
+    case TWOQ:
+        return std::make_unique<TwoQueueReplacement>(num_set, num_way);
+    case SHIP:
+        return std::make_unique<SHiPReplacement>(
+            num_set, num_way, property._rrpv_bits, property._bit_offset);
+    case HAWKEYE:
+        return std::make_unique<HawkeyeReplacement>(num_set, num_way,
+                                                    property._bit_offset);
+    default:
+        std::cerr << "Invalid replacement policy" << std::endl;
+        exit(-1);
+    }
+}
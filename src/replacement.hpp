@@ -0,0 +1,326 @@
+#ifndef _REPLACEMENT_HPP_
+#define _REPLACEMENT_HPP_
+
+#include "datatype.hpp"
+#include "next_use.hpp"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <vector>
+
+/*
+    Replacement engines keep their own per-line metadata in contiguous
+    arrays indexed by line number (set * ways + way).
+*/
+class BaseReplacement {
+  public:
+    explicit BaseReplacement(const ulint &num_set, const ulint &num_way);
+    virtual ~BaseReplacement() = default;
+
+    // Line (set, way) was hit
+    virtual void Hit(const ulint &set, const ulint &way) = 0;
+    // Line (set, way) was filled with block (address >> offset bits)
+    virtual void Fill(const ulint &set, const ulint &way,
+                      const addr_t &block) = 0;
+    // Way of the set to be replaced by block, always followed by the
+    // Fill() of that block
+    virtual ulint GetVictim(const ulint &set, const addr_t &block) = 0;
+    // True if the state of each set is only touched by accesses to that
+    // set, so disjoint sets can be simulated by different threads
+    virtual bool IsSetLocal() const { return true; }
+
+  protected:
+    ulint _num_set;
+    ulint _num_way;
+};
+
+/*
+    Every set draws its victims from its own xorshift64* stream seeded from
+    (seed, set), so results are reproducible and do not depend on how the
+    sets are split between threads.
+*/
+class RandomReplacement final : public BaseReplacement {
+  public:
+    explicit RandomReplacement(const ulint &num_set, const ulint &num_way,
+                               const ulint &seed);
+    void Hit(const ulint &, const ulint &) {}
+    void Fill(const ulint &, const ulint &, const addr_t &) {}
+    ulint GetVictim(const ulint &set, const addr_t &) {
+        uint64_t x = _state[set];
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        _state[set] = x;
+        // Upper 32 bits of the output scaled to [0, _num_way)
+        return ((x * 0x2545f4914f6cdd1dULL) >> 32) * _num_way >> 32;
+    }
+
+  private:
+    std::vector<uint64_t> _state; // xorshift state of each set, never 0
+};
+
+/*
+    One intrusive doubly-linked recency list per set, from MRU (head) to
+    LRU (tail). All ways start in the list with way 0 at the LRU end, so
+    invalid lines are always evicted before valid ones, lowest way first.
+*/
+class LRUReplacement final : public BaseReplacement {
+  public:
+    explicit LRUReplacement(const ulint &num_set, const ulint &num_way);
+    void Hit(const ulint &set, const ulint &way) { _MoveToHead(set, way); }
+    void Fill(const ulint &set, const ulint &way, const addr_t &) {
+        _MoveToHead(set, way);
+    }
+    ulint GetVictim(const ulint &set, const addr_t &) { return _tail[set]; }
+
+  private:
+    void _MoveToHead(const ulint &set, const ulint &way);
+
+    // Neighbours of each line, stored as way numbers within its set
+    std::vector<uint32_t> _prev;
+    std::vector<uint32_t> _next;
+    // MRU and LRU way of each set
+    std::vector<uint32_t> _head;
+    std::vector<uint32_t> _tail;
+};
+
+/*
+    Tree pseudo-LRU. The (ways - 1) nodes of a binary tree over the ways of
+    a set are stored as bits, node i (from 1) has children 2i and 2i + 1
+    and the leaves ways .. 2 ways - 1 are the ways. A node bit points to
+    the half holding the victim, 0 for the left one; every access flips the
+    bits on its path to point away from it. Ways must be a power of two.
+*/
+class PLRUReplacement final : public BaseReplacement {
+  public:
+    explicit PLRUReplacement(const ulint &num_set, const ulint &num_way);
+    void Hit(const ulint &set, const ulint &way) { _Touch(set, way); }
+    void Fill(const ulint &set, const ulint &way, const addr_t &) {
+        _Touch(set, way);
+    }
+    ulint GetVictim(const ulint &set, const addr_t &) {
+        const uint64_t *bits = &_bits[set * _num_word];
+        ulint node(1);
+        while (node < _num_way) {
+            ulint bit = node - 1;
+            node = 2 * node + ((bits[bit >> 6] >> (bit & 63)) & 1);
+        }
+        return node - _num_way;
+    }
+
+  private:
+    void _Touch(const ulint &set, const ulint &way) {
+        uint64_t *bits = &_bits[set * _num_word];
+        ulint node = way + _num_way;
+        // Walk up from the leaf, every parent points to the other child
+        for (; node > 1; node >>= 1) {
+            ulint parent = (node >> 1) - 1;
+            uint64_t mask = 1ULL << (parent & 63);
+            if (node & 1) {
+                bits[parent >> 6] &= ~mask;
+            } else {
+                bits[parent >> 6] |= mask;
+            }
+        }
+    }
+
+    ulint _num_word;             // # of 64-bit words of each set
+    std::vector<uint64_t> _bits; // node bits, node i at bit (i - 1)
+};
+
+/*
+    The reference bits of each set are packed in 64-bit words, way w at bit
+    w % 64 of word w / 64, so up to 64 ways fit in one word and the first
+    unreferenced way of a word is found by counting its trailing zeros.
+*/
+class ReferenceBits {
+  public:
+    explicit ReferenceBits(const ulint &num_set, const ulint &num_way)
+        : _num_word((num_way + 63) / 64),
+          _last_mask(num_way % 64 ? (1ULL << (num_way % 64)) - 1 : ~0ULL),
+          _bits(num_set * _num_word, 0) {}
+    void Set(const ulint &set, const ulint &way) {
+        _bits[set * _num_word + (way >> 6)] |= 1ULL << (way & 63);
+    }
+    uint64_t *GetWords(const ulint &set) { return &_bits[set * _num_word]; }
+    ulint GetNumWord() const { return _num_word; }
+    // Ways of a set held by word
+    uint64_t GetMask(const ulint &word) const {
+        return word + 1 == _num_word ? _last_mask : ~0ULL;
+    }
+
+  private:
+    ulint _num_word;
+    uint64_t _last_mask;
+    std::vector<uint64_t> _bits;
+};
+
+/*
+    Not recently used: every access sets the reference bit of its way, the
+    victim is the lowest way without one. Once every way is referenced the
+    bits of the set are cleared.
+*/
+class NRUReplacement final : public BaseReplacement {
+  public:
+    explicit NRUReplacement(const ulint &num_set, const ulint &num_way)
+        : BaseReplacement(num_set, num_way), _ref(num_set, num_way) {}
+    void Hit(const ulint &set, const ulint &way) { _ref.Set(set, way); }
+    void Fill(const ulint &set, const ulint &way, const addr_t &) {
+        _ref.Set(set, way);
+    }
+    ulint GetVictim(const ulint &set, const addr_t &) {
+        uint64_t *bits = _ref.GetWords(set);
+        for (ulint word = 0; word < _ref.GetNumWord(); word++) {
+            uint64_t unref = ~bits[word] & _ref.GetMask(word);
+            if (unref != 0) {
+                return (word << 6) + std::countr_zero(unref);
+            }
+        }
+        std::fill(bits, bits + _ref.GetNumWord(), 0);
+        return 0;
+    }
+
+  private:
+    ReferenceBits _ref;
+};
+
+/*
+    CLOCK, or second chance: the ways of a set form a circle swept by a
+    hand. Hits set the reference bit of their way and fills leave it clear.
+    The victim is the first way from the hand without a reference bit, the
+    referenced ways passed on the way lose theirs, and the hand stops just
+    after the victim.
+*/
+class ClockReplacement final : public BaseReplacement {
+  public:
+    explicit ClockReplacement(const ulint &num_set, const ulint &num_way)
+        : BaseReplacement(num_set, num_way), _ref(num_set, num_way),
+          _hand(num_set, 0) {}
+    void Hit(const ulint &set, const ulint &way) { _ref.Set(set, way); }
+    // The victim way was not referenced, so neither is the new block
+    void Fill(const ulint &, const ulint &, const addr_t &) {}
+    ulint GetVictim(const ulint &set, const addr_t &) {
+        uint64_t *bits = _ref.GetWords(set);
+        ulint word = _hand[set] >> 6;
+        // Ways of the word from the hand on
+        uint64_t range = _ref.GetMask(word) & (~0ULL << (_hand[set] & 63));
+        // Ends within one turn, which clears every bit
+        for (;;) {
+            uint64_t unref = ~bits[word] & range;
+            if (unref != 0) {
+                ulint bit = std::countr_zero(unref);
+                bits[word] &= ~(range & ((1ULL << bit) - 1));
+                ulint victim = (word << 6) + bit;
+                _hand[set] = victim + 1 == _num_way ? 0 : victim + 1;
+                return victim;
+            }
+            bits[word] &= ~range;
+            word = word + 1 == _ref.GetNumWord() ? 0 : word + 1;
+            range = _ref.GetMask(word);
+        }
+    }
+
+  private:
+    ReferenceBits _ref;
+    std::vector<uint32_t> _hand; // next way swept in each set
+};
+
+// Way of the first line of a set with the most distant prediction, the
+// lines of the set are aged until its prediction is max_rrpv
+inline ulint AgeToRRIPVictim(uint8_t *rrpv, const ulint &num_way,
+                             const uint8_t &max_rrpv) {
+    ulint victim(0);
+    for (ulint way = 1; way < num_way; way++) {
+        if (rrpv[way] > rrpv[victim]) {
+            victim = way;
+        }
+    }
+    uint8_t age = max_rrpv - rrpv[victim];
+    if (age != 0) {
+        for (ulint way = 0; way < num_way; way++) {
+            rrpv[way] += age;
+        }
+    }
+    return victim;
+}
+
+// BRRIP inserts one fill in this many of each set with a long prediction
+const ulint BRRIP_LONG_INTERVAL = 32;
+// # of leader sets of each policy and PSEL width of DRRIP
+const ulint DRRIP_NUM_LEADER = 32;
+const ulint DRRIP_PSEL_BITS = 10;
+// Leader sets are never closer than this, small caches keep followers
+const ulint DRRIP_MIN_LEADER_STRIDE = 4;
+
+/*
+    Re-reference interval prediction (Jaleel et al., ISCA 2010). Every line
+    has an RRPV of rrpv_bits bits, hits predict a near re-reference (0) and
+    the victim is the first line predicted distant (max), after aging the
+    whole set until one is. SRRIP inserts with a long prediction (max - 1),
+    BRRIP mostly with a distant one. DRRIP dedicates leader sets to each and
+    lets the others follow the one with fewer misses, counted in PSEL.
+*/
+class RRIPReplacement final : public BaseReplacement {
+  public:
+    explicit RRIPReplacement(const ReplacePolicies &policy,
+                             const ulint &num_set, const ulint &num_way,
+                             const ulint &rrpv_bits);
+    void Hit(const ulint &set, const ulint &way) {
+        _rrpv[set * _num_way + way] = 0;
+    }
+    void Fill(const ulint &set, const ulint &way, const addr_t &);
+    ulint GetVictim(const ulint &set, const addr_t &);
+    // DRRIP followers depend on the misses of the leader sets
+    bool IsSetLocal() const { return _policy != DRRIP; }
+
+  private:
+    bool _IsBimodal(const ulint &set);
+
+    ReplacePolicies _policy;
+    uint8_t _max_rrpv;
+    std::vector<uint8_t> _rrpv;       // RRPV of each line
+    std::vector<uint8_t> _fill_count; // BRRIP fills of each set
+
+    // DRRIP set dueling, set s leads SRRIP if s % _leader_stride == 0 and
+    // BRRIP if it is 1, no set leads if the stride is 0
+    ulint _leader_stride;
+    ulint _psel;
+};
+
+/*
+    Belady's OPT: evict the line whose next use is the furthest away. The
+    accesses of the cache are numbered in trace order, the n-th Hit() or
+    Fill() is the n-th access of the next-use index. The ways of each set
+    form a max-heap on their next use, so each access costs O(log ways).
+*/
+class OPTReplacement final : public BaseReplacement {
+  public:
+    explicit OPTReplacement(const ulint &num_set, const ulint &num_way,
+                            std::shared_ptr<const NextUseIndex> next_use);
+    void Hit(const ulint &set, const ulint &way) { _Access(set, way); }
+    void Fill(const ulint &set, const ulint &way, const addr_t &) {
+        _Access(set, way);
+    }
+    ulint GetVictim(const ulint &set, const addr_t &) {
+        return _heap[set * _num_way];
+    }
+    // Accesses have to be seen in trace order
+    bool IsSetLocal() const { return false; }
+
+  private:
+    void _Access(const ulint &set, const ulint &way);
+
+    std::shared_ptr<const NextUseIndex> _next_use;
+    ulint _time; // # of accesses so far
+
+    // Per line, indexed by set * ways + way (_key) or heap slot (_heap)
+    std::vector<uint32_t> _key;  // next use, UINT32_MAX if invalid
+    std::vector<uint32_t> _heap; // way in each heap slot
+    std::vector<uint32_t> _slot; // heap slot of each way
+};
+
+std::unique_ptr<BaseReplacement> MakeReplacement(const CacheProperty &property,
+                                                 const ulint &num_set,
+                                                 const ulint &num_way);
+
+#endif
@@ -0,0 +1,72 @@
+#include "shards.hpp"
+#include <algorithm>
+#include <cmath>
+
+Shards::Shards(const double &rate, const ulint &max_sample,
+               const ulint &seed)
+    : _seed(seed),
+      _threshold(std::max<ulint>(std::llround(rate * SHARDS_MODULUS), 1)),
+      _max_sample(max_sample), _num_access(0), _num_sampled(0),
+      _cold_weight(0.0) {}
+
+double Shards::GetRate() const {
+    return static_cast<double>(_threshold) / SHARDS_MODULUS;
+}
+
+void Shards::Access(const addr_raw_t &block) {
+    ++_num_access;
+    ulint hash = _Hash(block) % SHARDS_MODULUS;
+    if (hash >= _threshold) {
+        return;
+    }
+    ++_num_sampled;
+
+    double rate = GetRate();
+    ulint distance = _stack.Access(block);
+    if (distance == COLD_MISS) {
+        _cold_weight += 1.0 / rate;
+        _sampled_block.emplace(hash, block);
+        if (_max_sample != 0 && _sampled_block.size() > _max_sample) {
+            _Shrink();
+        }
+    } else {
+        _histogram[std::llround(distance / rate)] += 1.0 / rate;
+    }
+}
+
+void Shards::_Shrink() {
+    // Lower the threshold to the largest tracked hash, every block at or
+    // above it is no longer sampled
+    _threshold = _sampled_block.top().first;
+    while (!_sampled_block.empty() &&
+           _sampled_block.top().first >= _threshold) {
+        _stack.Remove(_sampled_block.top().second);
+        _sampled_block.pop();
+    }
+}
+
+double Shards::GetMissRatio(const ulint &num_block) const {
+    if (_num_access == 0 || num_block == 0) {
+        return _num_access == 0 ? 0.0 : 1.0;
+    }
+    // The sampled weights only estimate the # of accesses, dividing by the
+    // real count puts the difference at distance 0 (SHARDS-adj), where it
+    // hits in every cache size
+    double miss = _cold_weight;
+    for (auto it = _histogram.lower_bound(num_block); it != _histogram.end();
+         ++it) {
+        miss += it->second;
+    }
+    return std::clamp(miss / _num_access, 0.0, 1.0);
+}
+
+ulint Shards::_Hash(const addr_raw_t &block) const {
+    // MurmurHash3 64-bit finalizer of the block offset by the seed
+    ulint hash = block ^ (_seed * 0x9e3779b97f4a7c15ULL);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
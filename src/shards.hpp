@@ -0,0 +1,69 @@
+#ifndef _SHARDS_HPP_
+#define _SHARDS_HPP_
+
+#include "datatype.hpp"
+#include "stack_distance.hpp"
+#include <map>
+#include <queue>
+
+// Block hashes are reduced modulo this value before the threshold test
+const ulint SHARDS_MODULUS = 1 << 24;
+// shards_mode samples the trace this many times, with different hash seeds
+const ulint SHARDS_NUM_RUN = 8;
+
+/*
+    SHARDS (Spatially Hashed Approximate Reuse Distance Sampling). A block
+    is sampled if its hash modulo SHARDS_MODULUS is below a threshold, so
+    the sampling rate is R = threshold / SHARDS_MODULUS and every access to
+    a sampled block is kept. The sampled blocks go through an exact stack
+    distance analysis, a distance d among them stands for a distance d / R
+    in the full trace and each sampled access for 1 / R accesses.
+
+    With a sample size limit, only that many distinct blocks are tracked:
+    when it is exceeded the threshold drops to the largest tracked hash and
+    the blocks at or above it are forgotten, so the rate keeps decreasing
+    until the sampled blocks fit.
+
+    A whole block is sampled or not, so the error of an estimate depends on
+    which blocks are picked rather than on the # of sampled accesses. Runs
+    with different seeds pick independent sets of blocks, the spread of
+    their estimates measures that error.
+*/
+class Shards {
+  public:
+    // rate is the initial sampling rate in (0, 1], max_sample the # of
+    // distinct sampled blocks kept at once or 0 for no limit, seed picks
+    // the hash function
+    explicit Shards(const double &rate, const ulint &max_sample,
+                    const ulint &seed);
+
+    // Record an access to a block address
+    void Access(const addr_raw_t &block);
+
+    ulint GetAccess() const { return _num_access; }
+    ulint GetSampledAccess() const { return _num_sampled; }
+    double GetRate() const;
+    // Estimated # of distinct blocks of the whole trace
+    double GetNumBlock() const { return _cold_weight; }
+    // Estimated miss ratio of a fully-associative LRU cache with num_block
+    // blocks
+    double GetMissRatio(const ulint &num_block) const;
+
+  private:
+    ulint _Hash(const addr_raw_t &block) const;
+    void _Shrink();
+
+    ulint _seed;
+    StackDistance _stack;
+    ulint _threshold;
+    ulint _max_sample;
+    // (hash, block) of the tracked blocks, largest hash on top
+    std::priority_queue<std::pair<ulint, addr_raw_t>> _sampled_block;
+
+    ulint _num_access;  // # of accesses, sampled or not
+    ulint _num_sampled; // # of sampled accesses
+    double _cold_weight;
+    std::map<ulint, double> _histogram; // weight at each scaled distance
+};
+
+#endif
@@ -1,126 +1,366 @@
 #include "simulator.hpp"
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <thread>
 
-Simulator::Simulator(std::vector<CacheProperty> &cache_cfg_list,
+// Cache size in KB if it is a whole number of KB, in bytes otherwise
+static std::string SizeToString(const ulint &size) {
+    return size >= 1024 && size % 1024 == 0 ? std::to_string(size >> 10) + "KB"
+                                            : std::to_string(size) + "B";
+}
+
+CacheHierarchy::CacheHierarchy(const HierarchyConfig &cfg) : name(cfg.name) {
+    if (cfg.multi_level) {
+        for (auto it = cfg.cache_list.begin(); it != cfg.cache_list.end();
+             ++it) {
+            cache_list.push_back(MakeCache(*it));
+        }
+    } else {
+        cache_list.push_back(MakeCache(cfg.cache_list[0]));
+    }
+
+    ulint addr_width = cfg.cache_list[0]._addr_width;
+    max_addr = addr_width >= 64 ? ~0ULL : (1ULL << addr_width) - 1;
+}
+
+Simulator::Simulator(const std::vector<HierarchyConfig> &cfg_list,
                      const std::string &program_trace,
-                     const bool &multi_level_mode = false)
-    : _multi_level(multi_level_mode), trace_file(program_trace) {
+                     const SimulatorOption &option)
+    : _inst_batch(option.num_thread > 1 || option.num_shard > 1
+                      ? PARALLEL_BATCH_SIZE
+                      : INST_BATCH_SIZE),
+      _option(option), trace_file(program_trace) {
 
-    _SetupCache(cache_cfg_list);
+    // OPT caches get the future of the trace, only the first level sees
+    // the accesses in the order of the index. Block sizes share an index.
+    std::map<ulint, std::shared_ptr<const NextUseIndex>> next_use;
+    for (auto it = cfg_list.begin(); it != cfg_list.end(); ++it) {
+        HierarchyConfig cfg = *it;
+        CacheProperty &first = cfg.cache_list[0];
+        if (first.replacement_policy == OPT) {
+            auto &index = next_use[first._block_size];
+            if (!index) {
+                index = std::make_shared<NextUseIndex>(
+                    trace_file, log2l(first._block_size));
+            }
+            first._next_use = index;
+        }
+        _hierarchy_list.emplace_back(cfg);
+    }
 
     inst_loader = std::make_unique<InstructionLoader>(trace_file);
 }
 
 Simulator::~Simulator() = default;
 
-void Simulator::_SetupCache(const std::vector<CacheProperty> &_cfg_list) {
-    if (_multi_level) {
-        for (auto it = _cfg_list.begin(); it != _cfg_list.end(); ++it) {
-            _cache_hierarchy_list.push_back(MainCache(*it));
+void Simulator::RunSimulation() {
+    std::unique_ptr<PrefetchLoader> prefetch_loader;
+    if (_option.prefetch) {
+        prefetch_loader = std::make_unique<PrefetchLoader>(*inst_loader);
+    }
+    BatchSource next_batch = [&]() -> std::span<const inst_t> {
+        if (prefetch_loader) {
+            return prefetch_loader->GetNextChunk();
         }
+        ulint num_inst = inst_loader->GetNextBatch(_inst_batch);
+        return std::span<const inst_t>(_inst_batch.data(), num_inst);
+    };
+
+    ulint num_worker = std::min(_option.num_thread, _hierarchy_list.size());
+    if (_option.mode != cache_mode) {
+        _RunAnalysis(next_batch);
+        return;
+    } else if (_option.num_shard > 1) {
+        _RunSharded(next_batch, _option.num_shard);
+    } else if (num_worker > 1) {
+        _RunParallel(next_batch, num_worker);
     } else {
-        _cache_hierarchy_list.push_back(MainCache(_cfg_list[0]));
+        for (auto batch = next_batch(); !batch.empty(); batch = next_batch()) {
+            // Each hierarchy runs through the whole batch in turn, so that
+            // its cache state stays hot
+            for (auto &hierarchy : _hierarchy_list) {
+                _RunBatch(batch, hierarchy, hierarchy.counter);
+            }
+        }
+    }
+
+    for (auto &hierarchy : _hierarchy_list) {
+        _CalHitRate(hierarchy.counter);
     }
 }
 
-void Simulator::RunSimulation() {
-    while (inst_loader->IfAvailable()) {
-        try {
-            bool is_success = _CacheHandler(inst_loader->GetNextInst());
-            if (!is_success) {
-                throw std::logic_error("Cache Handler failed");
+void Simulator::_RunParallel(const BatchSource &next_batch,
+                             const ulint &num_worker) {
+    // Hierarchy i is owned by worker (i % num_worker). Every batch is
+    // decoded once by this thread and read by all workers, the two
+    // barrier phases publish a batch and wait for all workers to finish it.
+    std::span<const inst_t> batch;
+    std::barrier sync(num_worker + 1);
+
+    auto worker = [&](const ulint worker_id) {
+        for (;;) {
+            sync.arrive_and_wait();
+            if (batch.empty()) {
+                return;
             }
-        } catch (const std::exception &ex) {
-            std::cerr << ex.what() << std::endl;
-            exit(-1);
+            for (ulint i = worker_id; i < _hierarchy_list.size();
+                 i += num_worker) {
+                _RunBatch(batch, _hierarchy_list[i],
+                          _hierarchy_list[i].counter);
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (ulint i = 0; i < num_worker; i++) {
+        workers.emplace_back(worker, i);
+    }
+    for (;;) {
+        batch = next_batch();
+        sync.arrive_and_wait();
+        if (batch.empty()) {
+            break;
         }
+        sync.arrive_and_wait();
+    }
+    for (auto &thread : workers) {
+        thread.join();
     }
-    _CalHitRate();
 }
 
-bool Simulator::_CacheHandler(const inst_t &inst) {
-    addr_t next_addr = Cvt2AddrBits(inst.addr_raw);
+bool Simulator::_IsShardable(CacheHierarchy &hierarchy,
+                             const ulint &num_shard) {
+    // Only a single cache whose sets do not share any state can be split
+    BaseCache &_cache = *hierarchy.cache_list[0];
+    return hierarchy.cache_list.size() == 1 && _cache.IsSetLocal() &&
+           _cache.GetNumSet() >= num_shard;
+}
 
-    // Determine what kind of the instruction
-    switch (inst.op) {
-    case I_LOAD:
-        _Load(next_addr);
-        break;
-    case I_STORE:
-        _Store(next_addr);
-        break;
-    case I_NONE:
-        ++_counter.space;
-        break;
-    default:
-        std::cerr << "Unexpected error in _CacheHandler()" << std::endl;
-        std::cerr << "ERROR line: " << inst.addr_raw << std::endl;
-        return false;
+void Simulator::_RunSharded(const BatchSource &next_batch,
+                            const ulint &num_shard) {
+    std::vector<bool> shardable;
+    for (auto &hierarchy : _hierarchy_list) {
+        shardable.push_back(_IsShardable(hierarchy, num_shard));
+        if (!shardable.back()) {
+            std::cerr << "Warning: " << hierarchy.name
+                      << " cannot be split by set, simulated on one thread"
+                      << std::endl;
+        }
     }
-    return true;
-}
 
-void Simulator::_Load(const addr_t &addr) {
-    ++_counter.access;
-    ++_counter.load;
+    // Shard k owns the contiguous set range [k, k + 1) * num_set / num_shard
+    // of the current hierarchy and simulates queue[k], the instructions
+    // mapped to it, in trace order. Counters are kept per shard and merged
+    // at the end.
+    std::vector<std::vector<inst_t>> queue(num_shard);
+    std::vector<std::vector<COUNTER>> shard_counter(
+        _hierarchy_list.size(), std::vector<COUNTER>(num_shard));
+    ulint current(0);
+    bool done(false);
+    std::barrier sync(num_shard + 1);
 
-    if (_multi_level) {
-        bool _is_hit(false);
-        for (auto _cache = _cache_hierarchy_list.begin();
-             _cache != _cache_hierarchy_list.end() && !_is_hit; ++_cache) {
-            if (_cache->Get(addr)) {
-                _is_hit = true;
-                ++_counter.load_hit;
-            } else {
-                _is_hit = false;
-                _cache->Set(addr);
+    auto worker = [&](const ulint shard) {
+        for (;;) {
+            sync.arrive_and_wait();
+            if (done) {
+                return;
             }
+            _RunBatch(queue[shard], _hierarchy_list[current],
+                      shard_counter[current][shard]);
+            sync.arrive_and_wait();
         }
-    } else {
-        if (_cache_hierarchy_list[0].Get(addr)) {
-            ++_counter.load_hit;
-        } else {
-            _cache_hierarchy_list[0].Set(addr);
+    };
+
+    std::vector<std::thread> workers;
+    for (ulint i = 0; i < num_shard; i++) {
+        workers.emplace_back(worker, i);
+    }
+    for (auto batch = next_batch(); !batch.empty(); batch = next_batch()) {
+        for (current = 0; current < _hierarchy_list.size(); current++) {
+            CacheHierarchy &hierarchy = _hierarchy_list[current];
+            if (!shardable[current]) {
+                _RunBatch(batch, hierarchy, hierarchy.counter);
+                continue;
+            }
+
+            BaseCache &_cache = *hierarchy.cache_list[0];
+            ulint num_set = _cache.GetNumSet();
+            for (auto &_queue : queue) {
+                _queue.clear();
+            }
+            for (const inst_t &inst : batch) {
+                ulint set = _cache.GetSetNumber(inst.addr_raw);
+                queue[set * num_shard / num_set].push_back(inst);
+            }
+            sync.arrive_and_wait();
+            sync.arrive_and_wait();
+        }
+    }
+    done = true;
+    sync.arrive_and_wait();
+    for (auto &thread : workers) {
+        thread.join();
+    }
+
+    for (ulint i = 0; i < _hierarchy_list.size(); i++) {
+        COUNTER &_counter = _hierarchy_list[i].counter;
+        for (const COUNTER &_shard : shard_counter[i]) {
+            _counter.access += _shard.access;
+            _counter.load += _shard.load;
+            _counter.store += _shard.store;
+            _counter.space += _shard.space;
+            _counter.load_hit += _shard.load_hit;
+            _counter.store_hit += _shard.store_hit;
         }
     }
 }
 
-void Simulator::_Store(const addr_t &addr) {
-    ++_counter.access;
-    ++_counter.store;
+void Simulator::_RunAnalysis(const BatchSource &next_batch) {
+    // Reuse the block/set decomposition of the first L1 cache
+    CacheProperty property = _hierarchy_list[0].cache_list[0]->GetProperty();
+    addr_t max_addr = _hierarchy_list[0].max_addr;
+    if (_option.mode == mrc_mode) {
+        _stack_distance = std::make_unique<StackDistance>();
+    } else if (_option.mode == shards_mode) {
+        for (ulint seed = 0; seed < SHARDS_NUM_RUN; seed++) {
+            _shards.emplace_back(_option.sample_rate, _option.sample_size,
+                                 seed);
+        }
+    } else {
+        ulint max_way = property.associativity == full_associative
+                            ? property._num_block
+                            : property._num_way;
+        _all_associativity = std::make_unique<AllAssociativity>(
+            static_cast<ulint>(log2l(property._num_block)),
+            std::max(max_way, ALL_ASSOC_MIN_WAY), property._num_block);
+    }
 
-    if (_multi_level) {
-        bool _is_hit(false);
-        for (auto _cache = _cache_hierarchy_list.begin();
-             _cache != _cache_hierarchy_list.end() && !_is_hit; ++_cache) {
-            if (_cache->Get(addr)) {
-                _is_hit = true;
-                ++_counter.store_hit;
+    for (auto batch = next_batch(); !batch.empty(); batch = next_batch()) {
+        for (const inst_t &inst : batch) {
+            if (inst.op == I_NONE) {
+                continue;
+            }
+            if (inst.addr_raw > max_addr) {
+                std::cerr << "Address 0x" << std::hex << inst.addr_raw
+                          << std::dec << " does not fit in "
+                          << property._addr_width << " bits" << std::endl;
+                exit(-1);
+            }
+            addr_raw_t block = inst.addr_raw >> property._bit_offset;
+            if (_stack_distance) {
+                _stack_distance->Access(block);
+            } else if (!_shards.empty()) {
+                for (Shards &shards : _shards) {
+                    shards.Access(block);
+                }
             } else {
-                _is_hit = false;
-                _cache->Set(addr);
+                _all_associativity->Access(block);
             }
         }
-    } else {
-        if (_cache_hierarchy_list[0].Get(addr)) {
-            ++_counter.store_hit;
+    }
+}
+
+void Simulator::_RunBatch(std::span<const inst_t> batch,
+                          CacheHierarchy &hierarchy, COUNTER &counter) {
+    try {
+        for (const inst_t &inst : batch) {
+            bool is_success = _CountInst(hierarchy, counter, inst);
+            if (!is_success) {
+                throw std::logic_error("Cache Handler failed");
+            }
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        exit(-1);
+    }
+
+    // Each level runs through the accesses that missed in the level above,
+    // in trace order, which is the same as looking up the levels of every
+    // access in turn. Only one virtual call per level and batch is left.
+    thread_local std::vector<inst_t> pending, misses;
+    std::span<const inst_t> stream = batch;
+    for (auto &_cache : hierarchy.cache_list) {
+        misses.clear();
+        _cache->Access(stream, misses);
+        pending.swap(misses);
+        stream = pending;
+    }
+    for (const inst_t &inst : stream) {
+        if (inst.op == I_LOAD) {
+            --counter.load_hit;
         } else {
-            _cache_hierarchy_list[0].Set(addr);
+            --counter.store_hit;
         }
     }
 }
 
+bool Simulator::_CountInst(CacheHierarchy &hierarchy, COUNTER &_counter,
+                           const inst_t &inst) {
+    if (inst.addr_raw > hierarchy.max_addr) {
+        std::cerr << "Address 0x" << std::hex << inst.addr_raw << std::dec
+                  << " does not fit in the address width of "
+                  << hierarchy.name << std::endl;
+        return false;
+    }
+
+    // Determine what kind of the instruction, accesses are counted as hits
+    // until they miss in every level
+    switch (inst.op) {
+    case I_LOAD:
+        ++_counter.access;
+        ++_counter.load;
+        ++_counter.load_hit;
+        break;
+    case I_STORE:
+        ++_counter.access;
+        ++_counter.store;
+        ++_counter.store_hit;
+        break;
+    case I_NONE:
+        ++_counter.space;
+        break;
+    default:
+        std::cerr << "Unexpected error in _CountInst()" << std::endl;
+        std::cerr << "ERROR line: " << inst.addr_raw << std::endl;
+        return false;
+    }
+    return true;
+}
+
 void Simulator::DumpResult(const bool &oneline) {
 
     // TODO: dump simulation results to yaml file,
     //       then add another yaml parser to verify correctness.
 
-    if (oneline) {
-        std::cout << std::setprecision(6) << _counter.avg_hit_rate << std::endl;
-    } else {
+    if (_option.mode == mrc_mode) {
+        _DumpMissRatioCurve(oneline);
+        return;
+    } else if (_option.mode == allassoc_mode) {
+        _DumpAllAssociativity(oneline);
+        return;
+    } else if (_option.mode == shards_mode) {
+        _DumpShards(oneline);
+        return;
+    }
+
+    for (auto &hierarchy : _hierarchy_list) {
+        const COUNTER &_counter = hierarchy.counter;
+        if (oneline) {
+            std::cout << std::setprecision(6) << _counter.avg_hit_rate
+                      << std::endl;
+            continue;
+        }
         std::cout << "========================================" << std::endl;
         std::cout << "Test file: " << this->trace_file << std::endl;
+        if (_hierarchy_list.size() > 1) {
+            std::cout << "Config file: " << hierarchy.name << std::endl;
+        }
         std::cout << "----------------------------------------" << std::endl;
-        _ShowSettingInfo();
+        _ShowSettingInfo(hierarchy);
         std::cout << "----------------------------------------" << std::endl;
         std::cout << "Number of cache access: " << _counter.access << std::endl;
         std::cout << "Number of cache load: " << _counter.load << std::endl;
@@ -134,16 +374,152 @@ void Simulator::DumpResult(const bool &oneline) {
     }
 }
 
-void Simulator::_ShowSettingInfo() {
-    for (std::size_t i = 0; i < _cache_hierarchy_list.size(); i++) {
+void Simulator::_ShowSettingInfo(CacheHierarchy &hierarchy) {
+    std::vector<std::unique_ptr<BaseCache>> &_cache_list =
+        hierarchy.cache_list;
+    for (std::size_t i = 0; i < _cache_list.size(); i++) {
         std::cout << "# L" << i + 1 << " Cache" << std::endl;
-        _ShowSettingInfo(_cache_hierarchy_list[i]);
-        if (i != _cache_hierarchy_list.size() - 1)
+        _ShowSettingInfo(*_cache_list[i]);
+        if (i != _cache_list.size() - 1)
             std::cout << "---------------------------------------" << std::endl;
     }
 }
 
-void Simulator::_ShowSettingInfo(MainCache &_cache) {
+void Simulator::_DumpMissRatioCurve(const bool &oneline) {
+    ulint block_size =
+        _hierarchy_list[0].cache_list[0]->GetProperty()._block_size;
+    ulint num_distinct = _stack_distance->GetColdMiss();
+
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+        std::cout << "Test file: " << this->trace_file << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << "Fully-associative LRU, block size: " << block_size
+                  << "B" << std::endl;
+        std::cout << "Number of cache access: "
+                  << _stack_distance->GetAccess() << std::endl;
+        std::cout << "Number of distinct blocks: " << num_distinct
+                  << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << std::left << std::setw(16) << "Cache size"
+                  << "Hit rate" << std::endl;
+    }
+
+    // Every power-of-two size up to the one holding all distinct blocks
+    for (ulint num_block = 1;; num_block <<= 1) {
+        ulint size = num_block * block_size;
+        std::cout << std::left << std::setw(16) << SizeToString(size)
+                  << std::setprecision(6)
+                  << 1.0 - _stack_distance->GetMissRatio(num_block)
+                  << std::endl;
+        if (num_block >= num_distinct) {
+            break;
+        }
+    }
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+    }
+}
+
+void Simulator::_DumpAllAssociativity(const bool &oneline) {
+    ulint block_size =
+        _hierarchy_list[0].cache_list[0]->GetProperty()._block_size;
+
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+        std::cout << "Test file: " << this->trace_file << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << "All-associativity LRU, block size: " << block_size
+                  << "B" << std::endl;
+        std::cout << "Number of cache access: "
+                  << _all_associativity->GetAccess() << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << std::left << std::setw(10) << "Sets" << std::setw(8)
+                  << "Ways" << std::setw(16) << "Cache size"
+                  << "Hit rate" << std::endl;
+    }
+
+    for (ulint k = 0; k <= _all_associativity->GetMaxBitSet(); k++) {
+        for (ulint way = 1; way <= _all_associativity->GetNumWay(k); way++) {
+            ulint size = (1ULL << k) * way * block_size;
+            std::cout << std::left << std::setw(10) << (1ULL << k)
+                      << std::setw(8) << way << std::setw(16)
+                      << SizeToString(size)
+                      << std::setprecision(6)
+                      << _all_associativity->GetHitRate(k, way) << std::endl;
+        }
+    }
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+    }
+}
+
+void Simulator::_DumpShards(const bool &oneline) {
+    ulint block_size =
+        _hierarchy_list[0].cache_list[0]->GetProperty()._block_size;
+    double num_run = _shards.size();
+    double num_sampled(0.0), rate(0.0), num_distinct(0.0), min_rate(1.0);
+    for (const Shards &shards : _shards) {
+        num_sampled += shards.GetSampledAccess() / num_run;
+        rate += shards.GetRate() / num_run;
+        num_distinct += shards.GetNumBlock() / num_run;
+        min_rate = std::min(min_rate, shards.GetRate());
+    }
+
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+        std::cout << "Test file: " << this->trace_file << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << "Sampled fully-associative LRU, block size: "
+                  << block_size << "B" << std::endl;
+        std::cout << "Number of cache access: " << _shards[0].GetAccess()
+                  << std::endl;
+        std::cout << "Number of sampling runs: " << _shards.size()
+                  << std::endl;
+        std::cout << "Sampled access per run: " << std::fixed
+                  << std::setprecision(0) << num_sampled << std::defaultfloat
+                  << std::endl;
+        std::cout << "Final sampling rate: " << std::setprecision(6) << rate
+                  << std::endl;
+        std::cout << "Estimated distinct blocks: " << std::fixed
+                  << std::setprecision(0) << num_distinct << std::defaultfloat
+                  << std::endl;
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << std::left << std::setw(16) << "Cache size"
+                  << std::setw(16) << "Hit rate"
+                  << "Std. error" << std::endl;
+    }
+
+    // Scaled distances are multiples of 1 / R, smaller caches cannot be
+    // told apart. Every power-of-two size from there up to the estimated
+    // # of distinct blocks.
+    ulint min_block = std::ceil(1.0 / min_rate);
+    for (ulint num_block = std::bit_ceil(min_block);; num_block <<= 1) {
+        // The runs are independent estimates, the hit rate is their mean
+        // and its standard error comes from their spread
+        double sum(0.0), sum_square(0.0);
+        for (const Shards &shards : _shards) {
+            double hit_rate = 1.0 - shards.GetMissRatio(num_block);
+            sum += hit_rate;
+            sum_square += hit_rate * hit_rate;
+        }
+        double mean = sum / num_run;
+        double variance =
+            std::max(0.0, sum_square - num_run * mean * mean) / (num_run - 1);
+        std::cout << std::left << std::setw(16)
+                  << SizeToString(num_block * block_size)
+                  << std::setprecision(6) << std::setw(16) << mean
+                  << std::sqrt(variance / num_run) << std::endl;
+        if (num_block >= num_distinct) {
+            break;
+        }
+    }
+    if (!oneline) {
+        std::cout << "========================================" << std::endl;
+    }
+}
+
+void Simulator::_ShowSettingInfo(BaseCache &_cache) {
     CacheProperty _property = _cache.GetProperty();
 
     std::cout << "Cache size: " << _property._cache_size << "KB" << std::endl;
@@ -175,13 +551,52 @@ void Simulator::_ShowSettingInfo(MainCache &_cache) {
     case LRU:
         std::cout << "Replacement policy: LRU" << std::endl;
         break;
+    case PLRU:
+        std::cout << "Replacement policy: PLRU" << std::endl;
+        break;
+    case SRRIP:
+        std::cout << "Replacement policy: SRRIP" << std::endl;
+        break;
+    case BRRIP:
+        std::cout << "Replacement policy: BRRIP" << std::endl;
+        break;
+    case DRRIP:
+        std::cout << "Replacement policy: DRRIP" << std::endl;
+        break;
+    case OPT:
+        std::cout << "Replacement policy: OPT" << std::endl;
+        break;
+    case ARC:
+        std::cout << "Replacement policy: ARC" << std::endl;
+        break;
+    case CAR:
+        std::cout << "Replacement policy: CAR" << std::endl;
+        break;
+    case LIRS:
+        std::cout << "Replacement policy: LIRS" << std::endl;
+        break;
+    case TWOQ:
+        std::cout << "Replacement policy: 2Q" << std::endl;
+        break;
+    case SHIP:
+        std::cout << "Replacement policy: SHiP" << std::endl;
+        break;
+    case HAWKEYE:
+        std::cout << "Replacement policy: Hawkeye" << std::endl;
+        break;
+    case CLOCK:
+        std::cout << "Replacement policy: CLOCK" << std::endl;
+        break;
+    case NRU:
+        std::cout << "Replacement policy: NRU" << std::endl;
+        break;
     default:
         std::cerr << "Error replacement setting" << std::endl;
         exit(-1);
     }
 }
 
-void Simulator::_CalHitRate() {
+void Simulator::_CalHitRate(COUNTER &_counter) {
     const int miss_penalty(100);
     assert(_counter.access != 0);
     assert(_counter.load != 0);
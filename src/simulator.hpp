@@ -1,13 +1,43 @@
 #ifndef _SIMULATOR_HPP_
 #define _SIMULATOR_HPP_
 
+#include "all_associativity.hpp"
 #include "config_parser.hpp"
 #include "loader.hpp"
 #include "main_cache.hpp"
+#include "prefetch_loader.hpp"
+#include "shards.hpp"
+#include "stack_distance.hpp"
+#include <functional>
 #include <iomanip>
 #include <memory>
 #include <vector>
 
+// Instructions decoded per batch when hierarchies or the sets of a cache
+// run on worker threads
+const ulint PARALLEL_BATCH_SIZE = 65536;
+
+enum SimulationModes {
+    // What RunSimulation() computes
+    cache_mode,    // hit rate of each configured cache hierarchy
+    mrc_mode,      // LRU miss-ratio curve of fully-associative caches
+    allassoc_mode, // LRU hit rate of every (sets, ways) pair
+    shards_mode    // mrc_mode on a hash-sampled subset of the blocks
+};
+
+struct SimulatorOption {
+    SimulationModes mode;
+    bool prefetch;      // decode the trace on a background thread
+    ulint num_thread;   // # of threads simulating hierarchies concurrently
+    ulint num_shard;    // # of threads sharing the sets of one cache
+    double sample_rate; // initial sampling rate of shards_mode
+    ulint sample_size;  // max # of sampled blocks of shards_mode, 0 for all
+
+    explicit SimulatorOption()
+        : mode(cache_mode), prefetch(false), num_thread(1), num_shard(1),
+          sample_rate(0.01), sample_size(0) {}
+};
+
 struct COUNTER {
     ulint access;    // # of cache access
     ulint load;      // # of load inst.
@@ -27,30 +57,55 @@ struct COUNTER {
           store_hit_rate(0.0), amat(0.0) {}
 };
 
+// One simulated cache hierarchy and its statistics
+struct CacheHierarchy {
+    explicit CacheHierarchy(const HierarchyConfig &cfg);
+
+    std::string name;
+    std::vector<std::unique_ptr<BaseCache>> cache_list; // L1, L2, ...
+    addr_t max_addr; // largest address of the configured address width
+    COUNTER counter;
+};
+
 class Simulator {
   public:
-    explicit Simulator(std::vector<CacheProperty> &cache_cfg_list,
+    explicit Simulator(const std::vector<HierarchyConfig> &cfg_list,
                        const std::string &program_trace,
-                       const bool &multi_level_mode);
+                       const SimulatorOption &option);
     ~Simulator();
     void RunSimulation();
     void DumpResult(const bool &oneline); // Print simulation result
 
   private:
-    void _SetupCache(const std::vector<CacheProperty> &_cfg_list);
-    bool _CacheHandler(const inst_t &inst); // Main Instruction processing
-    void _Load(const addr_t &addr);
-    void _Store(const addr_t &addr);
-    void _CalHitRate(); // Caculate hit rate
-    void _ShowSettingInfo();
-    void _ShowSettingInfo(MainCache &_cache);
+    using BatchSource = std::function<std::span<const inst_t>()>;
+    void _RunParallel(const BatchSource &next_batch, const ulint &num_worker);
+    void _RunSharded(const BatchSource &next_batch, const ulint &num_shard);
+    bool _IsShardable(CacheHierarchy &hierarchy, const ulint &num_shard);
+    void _RunAnalysis(const BatchSource &next_batch);
+    void _RunBatch(std::span<const inst_t> batch, CacheHierarchy &hierarchy,
+                   COUNTER &counter);
+    // Count the kind of an instruction
+    bool _CountInst(CacheHierarchy &hierarchy, COUNTER &counter,
+                    const inst_t &inst);
+    void _CalHitRate(COUNTER &counter); // Caculate hit rate
+    void _ShowSettingInfo(CacheHierarchy &hierarchy);
+    void _ShowSettingInfo(BaseCache &_cache);
+    void _DumpMissRatioCurve(const bool &oneline);
+    void _DumpAllAssociativity(const bool &oneline);
+    void _DumpShards(const bool &oneline);
 
     std::unique_ptr<InstructionLoader> inst_loader;
-    std::vector<MainCache> _cache_hierarchy_list;
+    std::vector<inst_t> _inst_batch; // reused decode buffer
+    // Every hierarchy is driven by the same decoded trace
+    std::vector<CacheHierarchy> _hierarchy_list;
+    // Analysis engines fed with the blocks of the first L1 cache
+    std::unique_ptr<StackDistance> _stack_distance;       // mrc_mode
+    std::unique_ptr<AllAssociativity> _all_associativity; // allassoc_mode
+    // shards_mode, one run per hash seed
+    std::vector<Shards> _shards;
 
-    const bool _multi_level;
+    const SimulatorOption _option;
     const std::string &trace_file;
-    COUNTER _counter;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "stack_distance.hpp"
+#include <algorithm>
+
+const ulint INITIAL_CAPACITY = 1 << 16;
+
+StackDistance::StackDistance()
+    : _tree(INITIAL_CAPACITY + 1, 0), _time(0), _num_access(0),
+      _num_cold_miss(0) {}
+
+ulint StackDistance::Access(const addr_raw_t &block) {
+    if (_time == _tree.size() - 1) {
+        _Compact();
+    }
+    ++_num_access;
+
+    ulint distance(COLD_MISS);
+    auto it = _last_access.find(block);
+    if (it == _last_access.end()) {
+        ++_num_cold_miss;
+        _last_access.emplace(block, _time);
+    } else {
+        distance = _PrefixSum(_time) - _PrefixSum(it->second + 1);
+        if (distance >= _histogram.size()) {
+            _histogram.resize(distance + 1, 0);
+        }
+        ++_histogram[distance];
+        _Add(it->second, -1);
+        it->second = _time;
+    }
+    _Add(_time, 1);
+    ++_time;
+    return distance;
+}
+
+void StackDistance::Remove(const addr_raw_t &block) {
+    auto it = _last_access.find(block);
+    if (it != _last_access.end()) {
+        _Add(it->second, -1);
+        _last_access.erase(it);
+    }
+}
+
+double StackDistance::GetMissRatio(const ulint &num_block) const {
+    if (_num_access == 0) {
+        return 0.0;
+    }
+    ulint miss = GetColdMiss();
+    for (ulint d = num_block; d < _histogram.size(); d++) {
+        miss += _histogram[d];
+    }
+    return static_cast<double>(miss) / _num_access;
+}
+
+void StackDistance::_Add(ulint pos, const int &delta) {
+    for (++pos; pos < _tree.size(); pos += pos & (~pos + 1)) {
+        _tree[pos] += delta;
+    }
+}
+
+ulint StackDistance::_PrefixSum(ulint pos) const {
+    ulint sum(0);
+    for (; pos > 0; pos -= pos & (~pos + 1)) {
+        sum += _tree[pos];
+    }
+    return sum;
+}
+
+void StackDistance::_Compact() {
+    // Renumber the latest access times to 0 .. (# of blocks - 1), keeping
+    // their order, and leave as much room again for new accesses
+    std::vector<std::pair<ulint, addr_raw_t>> order;
+    order.reserve(_last_access.size());
+    for (const auto &entry : _last_access) {
+        order.emplace_back(entry.second, entry.first);
+    }
+    std::sort(order.begin(), order.end());
+
+    ulint capacity = std::max<ulint>(_tree.size() - 1, 2 * order.size());
+    _tree.assign(capacity + 1, 0);
+    for (_time = 0; _time < order.size(); _time++) {
+        _last_access[order[_time].second] = _time;
+        _Add(_time, 1);
+    }
+}
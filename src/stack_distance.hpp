@@ -0,0 +1,50 @@
+#ifndef _STACK_DISTANCE_HPP_
+#define _STACK_DISTANCE_HPP_
+
+#include "datatype.hpp"
+#include <unordered_map>
+#include <vector>
+
+const ulint COLD_MISS = ~0ULL;
+
+/*
+    Mattson stack distance analysis. The LRU stack distance of an access is
+    the number of distinct blocks referenced since the previous access to
+    the same block, so an access hits in every fully-associative LRU cache
+    with more blocks than its distance. A histogram of distances gives the
+    miss ratio of every cache size from one pass over the trace.
+
+    Every block marks its latest access time in a Fenwick tree, the
+    distance is the number of marks after the previous access time.
+*/
+class StackDistance {
+  public:
+    explicit StackDistance();
+
+    // Record an access to a block address, returns its stack distance or
+    // COLD_MISS on the first access to the block
+    ulint Access(const addr_raw_t &block);
+    // Forget a block, its next access is a cold miss again
+    void Remove(const addr_raw_t &block);
+
+    ulint GetAccess() const { return _num_access; }
+    ulint GetColdMiss() const { return _num_cold_miss; }
+    ulint GetNumBlock() const { return _last_access.size(); }
+    // Miss ratio of a fully-associative LRU cache with num_block blocks
+    double GetMissRatio(const ulint &num_block) const;
+
+  private:
+    void _Add(ulint pos, const int &delta);
+    ulint _PrefixSum(ulint pos) const; // # of marks in [0, pos)
+    void _Compact();
+
+    std::vector<int32_t> _tree; // Fenwick tree, 1-based
+    std::unordered_map<addr_raw_t, ulint> _last_access;
+    ulint _time; // next time stamp to be used
+
+    ulint _num_access;
+    ulint _num_cold_miss;
+    std::vector<ulint> _histogram; // # of accesses at each distance
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "tag_match.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cstring>
+#include <immintrin.h>
+#define TAG_MATCH_X86
+#endif
+
+template <typename Tag>
+static ulint _TagMatchScalar(const Tag *tags, const uint8_t *valid, ulint n,
+                             Tag tag) {
+    for (ulint i = 0; i < n; i++) {
+        if (tags[i] == tag && valid[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#ifdef TAG_MATCH_X86
+
+// Bit i is set if valid[i] != 0, for the first N (2 to 16) bytes
+template <ulint N> static inline int _ValidMask(const uint8_t *valid) {
+    __m128i v = _mm_setzero_si128();
+    std::memcpy(&v, valid, N);
+    return ~_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) &
+           ((1 << N) - 1);
+}
+
+__attribute__((target("sse4.2"))) static ulint
+_TagMatchSSE42(const tag_t *tags, const uint8_t *valid, ulint n, tag_t tag) {
+    const __m128i probe = _mm_set1_epi32(static_cast<int>(tag));
+    ulint i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags + i)),
+            probe);
+        int mask =
+            _mm_movemask_ps(_mm_castsi128_ps(eq)) & _ValidMask<4>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+__attribute__((target("avx2"))) static ulint
+_TagMatchAVX2(const tag_t *tags, const uint8_t *valid, ulint n, tag_t tag) {
+    const __m256i probe = _mm256_set1_epi32(static_cast<int>(tag));
+    ulint i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tags + i)),
+            probe);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq)) &
+                   _ValidMask<8>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+__attribute__((target("avx512f"))) static ulint
+_TagMatchAVX512(const tag_t *tags, const uint8_t *valid, ulint n, tag_t tag) {
+    const __m512i probe = _mm512_set1_epi32(static_cast<int>(tag));
+    ulint i = 0;
+    for (; i + 16 <= n; i += 16) {
+        int mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(tags + i),
+                                           probe) &
+                   _ValidMask<16>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+__attribute__((target("sse4.2"))) static ulint
+_TagMatch64SSE42(const wide_tag_t *tags, const uint8_t *valid, ulint n,
+                 wide_tag_t tag) {
+    const __m128i probe = _mm_set1_epi64x(static_cast<long long>(tag));
+    ulint i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i eq = _mm_cmpeq_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags + i)),
+            probe);
+        int mask =
+            _mm_movemask_pd(_mm_castsi128_pd(eq)) & _ValidMask<2>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+__attribute__((target("avx2"))) static ulint
+_TagMatch64AVX2(const wide_tag_t *tags, const uint8_t *valid, ulint n,
+                wide_tag_t tag) {
+    const __m256i probe = _mm256_set1_epi64x(static_cast<long long>(tag));
+    ulint i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tags + i)),
+            probe);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq)) &
+                   _ValidMask<4>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+__attribute__((target("avx512f"))) static ulint
+_TagMatch64AVX512(const wide_tag_t *tags, const uint8_t *valid, ulint n,
+                  wide_tag_t tag) {
+    const __m512i probe = _mm512_set1_epi64(static_cast<long long>(tag));
+    ulint i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(tags + i),
+                                           probe) &
+                   _ValidMask<8>(valid + i);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + _TagMatchScalar(tags + i, valid + i, n - i, tag);
+}
+
+#endif
+
+static TagMatchFunc<tag_t> _SelectTagMatch32() {
+#ifdef TAG_MATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return _TagMatchAVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return _TagMatchAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return _TagMatchSSE42;
+    }
+#endif
+    return _TagMatchScalar<tag_t>;
+}
+
+static TagMatchFunc<wide_tag_t> _SelectTagMatch64() {
+#ifdef TAG_MATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return _TagMatch64AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return _TagMatch64AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return _TagMatch64SSE42;
+    }
+#endif
+    return _TagMatchScalar<wide_tag_t>;
+}
+
+const TagMatchFunc<tag_t> TagMatch32 = _SelectTagMatch32();
+const TagMatchFunc<wide_tag_t> TagMatch64 = _SelectTagMatch64();
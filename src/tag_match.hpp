@@ -0,0 +1,29 @@
+#ifndef _TAG_MATCH_HPP_
+#define _TAG_MATCH_HPP_
+
+#include "datatype.hpp"
+
+/*
+    Way-compare kernel: returns the first i in [0, n) where tags[i] == tag
+    and valid[i] != 0, or n if there is no such way.
+    The implementation (AVX-512, AVX2, SSE4.2 or scalar) is picked once at
+    startup according to the features of the running CPU, for 32-bit and
+    64-bit tags separately.
+*/
+template <typename Tag>
+using TagMatchFunc = ulint (*)(const Tag *tags, const uint8_t *valid,
+                               ulint n, Tag tag);
+
+extern const TagMatchFunc<tag_t> TagMatch32;
+extern const TagMatchFunc<wide_tag_t> TagMatch64;
+
+inline ulint TagMatch(const tag_t *tags, const uint8_t *valid, ulint n,
+                      tag_t tag) {
+    return TagMatch32(tags, valid, n, tag);
+}
+inline ulint TagMatch(const wide_tag_t *tags, const uint8_t *valid, ulint n,
+                      wide_tag_t tag) {
+    return TagMatch64(tags, valid, n, tag);
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include "tag_store.hpp"
+#include <sys/mman.h>
+
+// Each array starts on its own cache line
+static size_t _AlignUp(const size_t &size) { return (size + 63) & ~63ULL; }
+
+template <typename Tag>
+TagStore<Tag>::TagStore(const ulint &num_line) {
+    size_t tag_size = _AlignUp(num_line * sizeof(Tag));
+    _buffer_size = tag_size + _AlignUp(num_line);
+
+    _buffer = mmap(nullptr, _buffer_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (_buffer == MAP_FAILED) {
+        std::cerr << "Cannot allocate the tag store of " << num_line
+                  << " lines" << std::endl;
+        exit(-1);
+    }
+#ifdef MADV_HUGEPAGE
+    // Large caches are probed at random lines, huge pages save TLB misses
+    if (_buffer_size >= HUGE_PAGE_SIZE) {
+        madvise(_buffer, _buffer_size, MADV_HUGEPAGE);
+    }
+#endif
+
+    char *base = static_cast<char *>(_buffer);
+    _tag = reinterpret_cast<Tag *>(base);
+    _valid = reinterpret_cast<uint8_t *>(base + tag_size);
+}
+
+template <typename Tag> TagStore<Tag>::~TagStore() {
+    munmap(_buffer, _buffer_size);
+}
+
+template class TagStore<tag_t>;
+template class TagStore<wide_tag_t>;
@@ -0,0 +1,51 @@
+#ifndef _TAG_STORE_HPP_
+#define _TAG_STORE_HPP_
+
+#include "datatype.hpp"
+#include "tag_match.hpp"
+
+// Tag stores at least this large are backed by transparent huge pages
+const ulint HUGE_PAGE_SIZE = 2 << 20;
+// Sets with fewer ways are searched inline rather than by the SIMD kernel
+const ulint SIMD_MIN_WAYS = 8;
+
+// Tag is tag_t or wide_tag_t, instantiated in tag_store.cpp
+template <typename Tag> class TagStore {
+  public:
+    explicit TagStore(const ulint &num_line);
+    ~TagStore();
+    TagStore(const TagStore &) = delete;
+    TagStore &operator=(const TagStore &) = delete;
+
+    // Install a tag into line idx, the line becomes valid
+    void Fill(const ulint &idx, const Tag &tag) {
+        _tag[idx] = tag;
+        _valid[idx] = 1;
+    }
+
+    // Search lines [first, last) for a valid line holding tag.
+    // Returns last if there is no such line.
+    ulint Find(const ulint &first, const ulint &last, const Tag &tag) const {
+        if (last - first >= SIMD_MIN_WAYS) {
+            return first + TagMatch(_tag + first, _valid + first,
+                                    last - first, tag);
+        }
+        for (ulint idx = first; idx < last; idx++) {
+            if (_tag[idx] == tag && _valid[idx]) {
+                return idx;
+            }
+        }
+        return last;
+    }
+
+  private:
+    // Structure of arrays, one entry per cache line, all carved out of a
+    // single anonymous mapping
+    Tag *_tag;
+    uint8_t *_valid;
+
+    void *_buffer;
+    size_t _buffer_size;
+};
+
+#endif
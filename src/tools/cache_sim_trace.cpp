@@ -0,0 +1,148 @@
+#include "argparse.hpp"
+#include "hex_parser.hpp"
+#include "loader.hpp"
+#include "trace_format.hpp"
+#include <cctype>
+#include <fstream>
+
+static void PrintUsage(const char *bin) {
+    std::cout << "Usage: " << bin << " <command> [options]" << std::endl;
+    std::cout << "Commands:" << std::endl;
+    std::cout << "    convert    Convert a text trace to the binary format"
+              << std::endl;
+    std::cout << "    hexcheck   Check the SIMD hex parser against the scalar "
+                 "one"
+              << std::endl;
+}
+
+static int Convert(int argc, char **argv) {
+    ArgumentParser parser("Argument parser");
+    parser.add_argument("-i", "Input trace file", true);
+    parser.add_argument("-o", "Output binary trace file", true);
+    parser.add_argument("-w", "--address-width",
+                        "Address width in bits, 32 (default) or 64", false);
+
+    try {
+        parser.parse(argc, argv);
+    } catch (const ArgumentParser::ArgumentNotFound &ex) {
+        std::cerr << ex.what() << std::endl;
+        parser.print_help();
+        return -1;
+    }
+
+    if (parser.is_help()) {
+        return 0;
+    }
+
+    uint16_t addr_width(32);
+    if (parser.exists("address-width")) {
+        addr_width = parser.get<uint16_t>("address-width");
+    }
+
+    InstructionLoader loader(parser.get<std::string>("i"));
+    BinaryTraceWriter writer(parser.get<std::string>("o"), addr_width);
+    ulint num_record(0);
+    while (loader.IfAvailable()) {
+        inst_t inst = loader.GetNextInst();
+        if (inst.op != I_NONE) {
+            writer.Write(inst);
+            ++num_record;
+        }
+    }
+    writer.Close();
+
+    std::cout << "Converted " << num_record << " records" << std::endl;
+    return 0;
+}
+
+// Both kernels must agree on the value, and on rejecting a bad digit
+static bool CheckHexParsers(const HexParseFunc &simd,
+                            const std::string &digits) {
+    addr_raw_t scalar_value(0), simd_value(0);
+    bool scalar_ok =
+        ParseHexScalar(digits.data(), digits.size(), scalar_value);
+    bool simd_ok = simd(digits.data(), digits.size(), simd_value);
+    return scalar_ok == simd_ok && scalar_value == simd_value;
+}
+
+static int HexCheck(int argc, char **argv) {
+    ArgumentParser parser("Argument parser");
+    parser.add_argument("-i", "Input text trace file", true);
+
+    try {
+        parser.parse(argc, argv);
+    } catch (const ArgumentParser::ArgumentNotFound &ex) {
+        std::cerr << ex.what() << std::endl;
+        parser.print_help();
+        return -1;
+    }
+
+    if (parser.is_help()) {
+        return 0;
+    }
+
+    HexParseFunc simd = GetHexParserSIMD();
+    if (simd == nullptr) {
+        std::cout << "No SIMD hex parser on this CPU" << std::endl;
+        return 0;
+    }
+
+    std::ifstream trace(parser.get<std::string>("i"));
+    if (!trace) {
+        std::cerr << "Cannot open trace " << parser.get<std::string>("i")
+                  << std::endl;
+        return -1;
+    }
+    // Each address is checked as is, widened to 16 digits, and with one
+    // digit made invalid
+    std::string line;
+    ulint num_addr(0), num_mismatch(0);
+    while (std::getline(trace, line)) {
+        std::size_t pos = line.find("0x");
+        if (pos == std::string::npos) {
+            continue;
+        }
+        std::string digits = line.substr(pos + 2);
+        while (!digits.empty() &&
+               std::isspace(static_cast<unsigned char>(digits.back()))) {
+            digits.pop_back();
+        }
+        if (digits.empty()) {
+            continue;
+        }
+        std::string wide = digits.size() < 16
+                               ? std::string(16 - digits.size(), 'f') + digits
+                               : digits;
+        std::string bad = digits;
+        bad[num_addr % bad.size()] = 'g';
+        for (const std::string &s : {digits, wide, bad}) {
+            if (!CheckHexParsers(simd, s)) {
+                std::cerr << "Kernels disagree on " << s << std::endl;
+                ++num_mismatch;
+            }
+        }
+        ++num_addr;
+    }
+
+    std::cout << "Checked " << num_addr << " addresses, " << num_mismatch
+              << " mismatches" << std::endl;
+    return num_mismatch == 0 ? 0 : -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    std::string command(argv[1]);
+    if (command == "convert") {
+        return Convert(argc - 1, argv + 1);
+    } else if (command == "hexcheck") {
+        return HexCheck(argc - 1, argv + 1);
+    }
+
+    std::cerr << "Unknown command: " << command << std::endl;
+    PrintUsage(argv[0]);
+    return -1;
+}
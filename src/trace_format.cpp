@@ -0,0 +1,50 @@
+#include "trace_format.hpp"
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string &filename,
+                                     const uint16_t &addr_width)
+    : _out_file(filename, std::ios::out | std::ios::binary) {
+    if (addr_width != 32 && addr_width != 64) {
+        std::cerr << "Unsupported address width: " << addr_width << std::endl;
+        exit(-1);
+    }
+    if (_out_file.fail()) {
+        std::cerr << "Open output trace file error" << std::endl;
+        exit(-1);
+    }
+
+    std::memcpy(_header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    _header.version = TRACE_FORMAT_VERSION;
+    _header.addr_width = addr_width;
+    _header.num_record = 0;
+    _out_file.write(reinterpret_cast<const char *>(&_header), sizeof(_header));
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() { Close(); }
+
+void BinaryTraceWriter::Write(const inst_t &inst) {
+    if (_header.addr_width < 64 && (inst.addr_raw >> _header.addr_width)) {
+        std::cerr << "Address 0x" << std::hex << inst.addr_raw << std::dec
+                  << " does not fit in " << _header.addr_width << " bits"
+                  << std::endl;
+        exit(-1);
+    }
+
+    char record[sizeof(uint8_t) + sizeof(addr_raw_t)];
+    record[0] = static_cast<char>(inst.op);
+    std::memcpy(record + 1, &inst.addr_raw, _header.addr_width / 8);
+    _out_file.write(record, TraceRecordSize(_header.addr_width));
+    ++_header.num_record;
+}
+
+void BinaryTraceWriter::Close() {
+    if (!_out_file.is_open()) {
+        return;
+    }
+    _out_file.seekp(0);
+    _out_file.write(reinterpret_cast<const char *>(&_header), sizeof(_header));
+    _out_file.close();
+    if (_out_file.fail()) {
+        std::cerr << "Write output trace file error" << std::endl;
+        exit(-1);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef _TRACE_FORMAT_HPP_
+#define _TRACE_FORMAT_HPP_
+
+#include "datatype.hpp"
+#include <cstring>
+#include <string>
+
+/*
+    Binary trace file layout, all fields little-endian:
+
+    header (16 bytes)
+        [0, 4)   magic "CSTB"
+        [4, 6)   format version
+        [6, 8)   address width in bits (32 or 64)
+        [8, 16)  number of records
+    records, packed back to back
+        [0, 1)   op, I_LOAD or I_STORE
+        [1, 1 + address width / 8)  address
+*/
+const char TRACE_MAGIC[4] = {'C', 'S', 'T', 'B'};
+const uint16_t TRACE_FORMAT_VERSION = 1;
+
+struct TraceHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t addr_width;
+    uint64_t num_record;
+};
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader must be packed");
+
+inline bool IsBinaryTrace(const char *data, const size_t &size) {
+    return size >= sizeof(TraceHeader) &&
+           std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+}
+
+inline size_t TraceRecordSize(const uint16_t &addr_width) {
+    return 1 + addr_width / 8;
+}
+
+class BinaryTraceWriter {
+  public:
+    explicit BinaryTraceWriter(const std::string &filename,
+                               const uint16_t &addr_width);
+    ~BinaryTraceWriter();
+    void Write(const inst_t &inst);
+    // Write back the record count to the header and close the file
+    void Close();
+
+  private:
+    std::ofstream _out_file;
+    TraceHeader _header;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#include "two_queue_replacement.hpp"
+
+TwoQueueReplacement::TwoQueueReplacement(const ulint &num_set,
+                                         const ulint &num_way)
+    : BaseReplacement(num_set, num_way),
+      _max_in(std::max<ulint>(1, num_way * TWOQ_IN_PERCENT / 100)),
+      _max_out(std::max<ulint>(1, num_way * TWOQ_OUT_PERCENT / 100)),
+      _ghosts("2Q", num_set, num_way, _max_out),
+      _lists(num_way + _max_out, NUM_LIST), _block(num_way, 0),
+      _fill_list(A1IN) {}
+
+ulint TwoQueueReplacement::GetVictim(const ulint &, const addr_t &block) {
+    uint32_t node = _ghosts.Find(block);
+    _fill_list = A1IN;
+    if (node != NO_NODE) {
+        _fill_list = AM;
+        _DropGhost(node);
+    }
+
+    uint32_t free_way = _ghosts.PopFreeWay();
+    if (free_way != NO_NODE) {
+        return free_way;
+    }
+
+    if (_lists.Size(A1IN) <= _max_in && _lists.Size(AM) != 0) {
+        uint32_t way = _lists.Head(AM);
+        _lists.Remove(way);
+        return way;
+    }
+    uint32_t way = _lists.Head(A1IN);
+    _lists.Remove(way);
+    if (_ghosts.IsFull()) {
+        _DropGhost(_lists.Head(A1OUT));
+    }
+    _lists.PushTail(A1OUT, _ghosts.Add(_block[way]));
+    return way;
+}
+
+void TwoQueueReplacement::_DropGhost(const uint32_t &node) {
+    _lists.Remove(node);
+    _ghosts.Drop(node);
+}
@@ -0,0 +1,51 @@
+#ifndef _TWO_QUEUE_REPLACEMENT_HPP_
+#define _TWO_QUEUE_REPLACEMENT_HPP_
+
+#include "ghost_table.hpp"
+#include "replacement.hpp"
+#include <algorithm>
+
+// Ways of A1in (Kin) and ghosts of A1out (Kout) in percent of the cache,
+// the values recommended by Johnson and Shasha
+const ulint TWOQ_IN_PERCENT = 25;
+const ulint TWOQ_OUT_PERCENT = 50;
+
+/*
+    Full 2Q (Johnson and Shasha, VLDB 1994) for fully-associative caches.
+    Blocks seen once enter the FIFO A1in; once it holds more than Kin ways
+    its oldest block is evicted and remembered in the ghost FIFO A1out.
+    Blocks missed while in A1out go to Am, the LRU list of hot blocks, so a
+    scan only flushes A1in. A1out holds the Kout ghosts of a GhostTable.
+*/
+class TwoQueueReplacement final : public BaseReplacement {
+  public:
+    explicit TwoQueueReplacement(const ulint &num_set, const ulint &num_way);
+    void Hit(const ulint &, const ulint &way) {
+        // Hits in A1in are correlated references and are not promoted
+        if (_lists.Owner(way) == AM) {
+            _lists.Remove(way);
+            _lists.PushTail(AM, way);
+        }
+    }
+    void Fill(const ulint &, const ulint &way, const addr_t &block) {
+        _block[way] = block;
+        _lists.PushTail(_fill_list, way);
+    }
+    ulint GetVictim(const ulint &, const addr_t &block);
+
+  private:
+    enum _ListId : uint8_t { A1IN, AM, A1OUT, NUM_LIST };
+
+    void _DropGhost(const uint32_t &node);
+
+    ulint _max_in;  // Kin
+    ulint _max_out; // Kout
+    GhostTable _ghosts;
+    NodeLists _lists;
+    std::vector<addr_t> _block; // block of each way
+
+    // List of the block being filled, set by GetVictim()
+    _ListId _fill_list;
+};
+
+#endif
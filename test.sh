@@ -2,38 +2,57 @@
 cd build
 cmake ..
 make -j
-./cache_sim -t ../TestData/gcc.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/gzip.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/mcf.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/swim.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/twolf.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/curl.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/ls.trace -c ../TestData/cache1.json
-./cache_sim -t ../TestData/tar.trace -c ../TestData/cache1.json
+for trace in gcc gzip mcf swim twolf curl ls tar; do
+    ./cache_sim -t ../TestData/$trace.trace -c ../TestData/cache1.json \
+        ../TestData/cache2.json ../TestData/cache3.json ../TestData/cache4.json
+done
+# The SIMD hex parser must decode every address like the scalar loop
+for trace in ls swim; do
+    ./cache_sim_trace hexcheck -i ../TestData/$trace.trace || exit 1
+done
 
-./cache_sim -t ../TestData/gcc.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/gzip.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/mcf.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/swim.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/twolf.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/curl.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/ls.trace -c ../TestData/cache2.json
-./cache_sim -t ../TestData/tar.trace -c ../TestData/cache2.json
+# Regression checks, one-line results must match the ones recorded in
+# TestData/expected. The policy results were checked against simple
+# list-based models of each policy.
+status=0
+check() {
+    expected=../TestData/expected/$1.txt
+    shift
+    if ./cache_sim -q "$@" | cmp -s - $expected; then
+        echo "PASS $expected: $*"
+    else
+        echo "FAIL $expected: $*"
+        status=1
+    fi
+}
 
-./cache_sim -t ../TestData/gcc.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/gzip.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/mcf.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/swim.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/twolf.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/curl.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/ls.trace -c ../TestData/cache3.json
-./cache_sim -t ../TestData/tar.trace -c ../TestData/cache3.json
+# Every replacement policy, in the order of the expected hit rates
+policies=""
+for policy in random lru plru clock nru srrip brrip drrip opt ship hawkeye \
+    arc car lirs 2q; do
+    policies="$policies ../TestData/policy/$policy.json"
+done
+for trace in ls swim; do
+    check policies-$trace -t ../TestData/$trace.trace -c $policies
+    # Threads, prefetching and set sharding leave the results unchanged
+    check policies-$trace -t ../TestData/$trace.trace -c $policies -j 4
+    check policies-$trace -t ../TestData/$trace.trace -c $policies -p
+    check policies-$trace -t ../TestData/$trace.trace -c $policies -s 4 \
+        2>/dev/null
+    # So does the binary trace format
+    ./cache_sim_trace convert -i ../TestData/$trace.trace -o $trace.btrace \
+        >/dev/null
+    check policies-$trace -t $trace.btrace -c $policies
+done
 
-./cache_sim -t ../TestData/gcc.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/gzip.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/mcf.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/swim.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/twolf.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/curl.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/ls.trace -c ../TestData/cache4.json
-./cache_sim -t ../TestData/tar.trace -c ../TestData/cache4.json
\ No newline at end of file
+# 64-bit addresses through a pipe are read by the stream loader
+sed 's/0x/0x00007fff/' ../TestData/ls.trace >ls64.trace
+check cache64-ls -t /dev/stdin -c ../TestData/cache64.json <ls64.trace
+
+# Analysis modes
+check mrc-ls -t ../TestData/ls.trace -c ../TestData/cache3.json -m mrc
+check allassoc-ls -t ../TestData/ls.trace -c ../TestData/cache3.json \
+    -m allassoc
+check shards-ls -t ../TestData/ls.trace -c ../TestData/cache3.json \
+    -m shards -r 0.1
+exit $status